@@ -0,0 +1,406 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_BATCH_HPP
+#define POLYNOMIAL_BATCH_HPP
+
+#include "Polynomial.hpp"
+#include "Simd.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Polynomials
+{
+
+namespace detail
+{
+
+template <class V, std::size_t... Is, class... Ps, class... Vs>
+inline V eval_lanes_naive(
+    const std::array<V, sizeof...(Is)> &coeffs, std::index_sequence<Is...>, PowersList<Ps...>,
+    const Vs &...xs) noexcept
+{
+    V acc(0);
+    ((acc = fma(raise(Ps{}, xs...), coeffs[Is], acc)), ...);
+    return acc;
+}
+
+// Naive evaluation in lanes is a chain of multiply-adds, one per term.
+template <class V, std::size_t N, class... Ps, class... Vs>
+inline V eval_lanes(Naive, const std::array<V, N> &coeffs, PowersList<Ps...>, const Vs &...xs) noexcept
+{
+    return eval_lanes_naive(coeffs, std::make_index_sequence<N>(), PowersList<Ps...>{}, xs...);
+}
+
+template <class Strategy, class V, std::size_t N, class... Ps, class... Vs>
+inline V eval_lanes(Strategy, const std::array<V, N> &coeffs, PowersList<Ps...>, const Vs &...xs) noexcept
+{
+    return evaluate(Strategy{}, coeffs, PowersList<Ps...>{}, xs...);
+}
+
+// Lanes of the intrinsic specializations use a hardware fma when the target has one.
+template <class T, std::size_t W>
+constexpr bool fast_fma_v<simd::Vec<T, W>> = simd::Vec<T, W>::fused_fma;
+
+// The value and error estimate of a compensated evaluation, one point per lane.
+template <class V, class Result>
+struct CompensatedLanes
+{
+    Compensated<V> sum;
+};
+
+// The error-free transformations of compensated Horner act on whole vectors of lanes.
+template <class Work, class Result, class V, std::size_t N, class... Ps, class... Vs>
+inline CompensatedLanes<V, Result> eval_lanes(
+    CompensatedHorner<Work, Result>, const std::array<V, N> &coeffs, PowersList<Ps...>,
+    const Vs &...xs) noexcept
+{
+    return CompensatedLanes<V, Result>{
+        horner_plan_t<PowersList<Ps...>>::template eval_compensated<V>(coeffs, std::make_tuple(xs...))};
+}
+
+template <class V, class C, class X>
+inline V load_lanes(const X *src, std::size_t count) noexcept
+{
+    if constexpr (std::is_same_v<C, X>)
+    {
+        if (count == V::width)
+        {
+            return V::load(src);
+        }
+    }
+    C buf[V::width] = {};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        buf[i] = static_cast<C>(src[i]);
+    }
+    return V::load(buf);
+}
+
+template <class V, class C, class R>
+inline void store_lanes(const V &v, R *dst, std::size_t count) noexcept
+{
+    if constexpr (std::is_same_v<C, R>)
+    {
+        if (count == V::width)
+        {
+            v.store(dst);
+            return;
+        }
+    }
+    C buf[V::width];
+    v.store(buf);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        dst[i] = static_cast<R>(buf[i]);
+    }
+}
+
+// Each lane's result is value + error, summed in Result as in the single point evaluation.
+template <class V, class C, class Result, class R>
+inline void store_lanes(const CompensatedLanes<V, Result> &v, R *dst, std::size_t count) noexcept
+{
+    C value[V::width], error[V::width];
+    v.sum.value.store(value);
+    v.sum.error.store(error);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        dst[i] = static_cast<R>(static_cast<Result>(value[i]) + static_cast<Result>(error[i]));
+    }
+}
+
+template <class C, class Strategy, class T, class... Ps, class R, class... Xs>
+void evaluate_batch_as(
+    Strategy, const Polynomial<T, Ps...> &p, R *out, std::size_t n, const Xs *...xs) noexcept
+{
+    static_assert(
+        sizeof...(Xs) == PowersList<Ps...>::nvars, "Need one input array per polynomial variable");
+    using V = simd::native_vec<C>;
+    constexpr std::size_t W = V::width;
+
+    std::array<V, sizeof...(Ps)> coeffs;
+    for (std::size_t i = 0; i < sizeof...(Ps); ++i)
+    {
+        coeffs[i] = V(static_cast<C>(p.coeffs()[i]));
+    }
+
+    std::size_t i = 0;
+    for (; i + W <= n; i += W)
+    {
+        const auto result =
+            eval_lanes(Strategy{}, coeffs, PowersList<Ps...>{}, load_lanes<V, C>(xs + i, W)...);
+        store_lanes<V, C>(result, out + i, W);
+    }
+
+    if (i < n)
+    {
+        const std::size_t rest = n - i;
+        const auto result =
+            eval_lanes(Strategy{}, coeffs, PowersList<Ps...>{}, load_lanes<V, C>(xs + i, rest)...);
+        store_lanes<V, C>(result, out + i, rest);
+    }
+}
+
+/*
+ * The powers x^0, ..., x^Max of a group of lanes. As an argument of eval_impl, raise<P> on it is a
+ * lookup, so each power is computed once per group and shared by all the terms.
+ */
+template <class V, unsigned Max>
+struct LanePowers
+{
+    std::array<V, Max + 1> powers;
+
+    explicit LanePowers(const V &x) noexcept : powers{power_ladder<Max>(x)} {}
+};
+
+template <unsigned P, class V, unsigned Max>
+inline V raise(const LanePowers<V, Max> &x) noexcept
+{
+    static_assert(P <= Max, "Power is beyond the end of the ladder");
+    if constexpr (P == 0)
+    {
+        return V(1);
+    }
+    else
+    {
+        return x.powers[P];
+    }
+}
+
+// The fold over terms of Polynomial::operator(), applied to the points held in a group of lanes.
+template <class V, std::size_t N, class... Ps, std::size_t... Vs, class... Ls>
+inline V eval_group(
+    const std::array<V, N> &coeffs, PowersList<Ps...>, std::index_sequence<Vs...>, const Ls &...xs) noexcept
+{
+    constexpr auto maxes = max_degrees(PowersList<Ps...>{});
+    return eval_impl(
+        coeffs, std::make_index_sequence<N>(), PowersList<Ps...>{}, LanePowers<V, maxes[Vs]>(xs)...);
+}
+
+template <class R, class... Qs, class Ladders>
+constexpr std::array<R, sizeof...(Qs)>
+monomials_from_table(PowersList<Qs...>, const Ladders &ladders) noexcept
+{
+    return std::array<R, sizeof...(Qs)>{static_cast<R>(multiply_table_factors<0, Qs>(R(1), ladders))...};
+}
+
+// Number of points handled together by the blocked monomials kernel.
+constexpr std::size_t monomial_block_size = 64;
+
+} // namespace detail
+
+/*
+ * Evaluate p at n points given in structure-of-arrays form, one array per variable, writing p(x_i)
+ * to out[i]. Points are processed simd::native_width lanes at a time; the computation is done in
+ * the common type of the coefficients and the inputs.
+ */
+template <class T, class... Ps, class R, class... Xs>
+void evaluate_batch(const Polynomial<T, Ps...> &p, R *out, std::size_t n, const Xs *...xs) noexcept
+{
+    detail::evaluate_batch_as<std::common_type_t<T, Xs...>>(Naive{}, p, out, n, xs...);
+}
+
+/*
+ * As above, but computing in Acc regardless of the storage types, e.g. to keep float coefficients
+ * and inputs (half the memory traffic) while accumulating in double. Each group of lanes is
+ * evaluated with Strategy, as Polynomial::evaluate does for a single point.
+ */
+template <class Acc, class Strategy, class T, class... Ps, class R, class... Xs>
+void evaluate_batch(
+    Accumulate<Acc, Strategy>, const Polynomial<T, Ps...> &p, R *out, std::size_t n,
+    const Xs *...xs) noexcept
+{
+    detail::evaluate_batch_as<Acc>(Strategy{}, p, out, n, xs...);
+}
+
+/*
+ * Compensated Horner evaluation (see CompensatedHorner) of p at n points, e.g. to evaluate float
+ * data to close to double accuracy while reading only float coefficients and inputs. The error-free
+ * transformations run on simd::native_width lanes of Work at a time; the points left over after the
+ * last full group are evaluated one at a time.
+ */
+template <class Work, class Result, class T, class... Ps, class R, class... Xs>
+void evaluate_batch(
+    CompensatedHorner<Work, Result>, const Polynomial<T, Ps...> &p, R *out, std::size_t n,
+    const Xs *...xs) noexcept
+{
+    constexpr std::size_t W = simd::native_width_v<Work>;
+    const std::size_t full = n - n % W;
+    detail::evaluate_batch_as<Work>(CompensatedHorner<Work, Result>{}, p, out, full, xs...);
+    for (std::size_t i = full; i < n; ++i)
+    {
+        out[i] = static_cast<R>(p.evaluate(CompensatedHorner<Work, Result>{}, xs[i]...));
+    }
+}
+
+/*
+ * Evaluate p at n points given one array per variable, G points at a time in lockstep. Each group
+ * is held in simd::Vec<C, G> lanes and folded over the terms as by operator(), so every term's
+ * multiply-add is issued for all G points back to back; in a scalar build this keeps G independent
+ * accumulations in flight to hide the latency of each. The powers of each variable are computed
+ * once per group. A final partial group is padded with zeros. C is the common type of the
+ * coefficients and the inputs; G of 4 or 8 is usually enough to cover the latency of a multiply-add.
+ */
+template <std::size_t G, class T, class... Ps, class R, class... Xs>
+void evaluate_interleaved(const Polynomial<T, Ps...> &p, R *out, std::size_t n, const Xs *...xs) noexcept
+{
+    static_assert(G > 0, "Group size must be positive");
+    static_assert(
+        sizeof...(Xs) == PowersList<Ps...>::nvars, "Need one input array per polynomial variable");
+    using C = std::common_type_t<T, Xs...>;
+    using V = simd::Vec<C, G>;
+
+    std::array<V, sizeof...(Ps)> coeffs;
+    for (std::size_t i = 0; i < sizeof...(Ps); ++i)
+    {
+        coeffs[i] = V(static_cast<C>(p.coeffs()[i]));
+    }
+
+    for (std::size_t i = 0; i < n; i += G)
+    {
+        const std::size_t count = n - i < G ? n - i : G;
+        const V values = detail::eval_group(
+            coeffs, PowersList<Ps...>{}, std::index_sequence_for<Xs...>(),
+            detail::load_lanes<V, C>(xs + i, count)...);
+        detail::store_lanes<V, C>(values, out + i, count);
+    }
+}
+
+// The values of p at the G points xs[0], ..., xs[G - 1], evaluated in lockstep as above.
+template <std::size_t G, class T, class... Ps, class R, class... Xs>
+void evaluate_group(const Polynomial<T, Ps...> &p, R *out, const Xs *...xs) noexcept
+{
+    evaluate_interleaved<G>(p, out, G, xs...);
+}
+
+enum class MatrixLayout
+{
+    RowMajor,
+    ColumnMajor
+};
+
+/*
+ * The values of the monomials in PowersList<Ps...> at a single point, in the order produced by
+ * unique_and_sorted, so that they line up with Polynomial::coeffs().
+ */
+template <class... Ps, class... Xs>
+constexpr auto monomials(PowersList<Ps...>, const Xs &...xs) noexcept
+    -> std::array<std::common_type_t<Xs...>, decltype(unique_and_sorted(PowersList<Ps...>{}).second)::size>
+{
+    static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Wrong number of arguments to monomials");
+    using R = std::common_type_t<Xs...>;
+    constexpr auto final_powers = unique_and_sorted(PowersList<Ps...>{}).second;
+    const auto ladders =
+        detail::make_power_ladders<decltype(final_powers)>(std::index_sequence_for<Xs...>(), xs...);
+    return detail::monomials_from_table<R>(final_powers, ladders);
+}
+
+/*
+ * Fill the n x num_terms Vandermonde matrix of PowersList<Ps...> for n points given as one array
+ * per variable; column j holds the j-th monomial in the order produced by unique_and_sorted. The
+ * points are processed in blocks whose power ladders stay in L1 cache.
+ */
+template <class... Ps, class R, class... Xs>
+void monomials(PowersList<Ps...>, MatrixLayout layout, R *out, std::size_t n, const Xs *...xs) noexcept
+{
+    static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Need one input array per variable");
+    using X = std::common_type_t<Xs...>;
+    static_assert((std::is_same_v<X, Xs> && ...), "All input arrays should have the same type");
+    constexpr auto final_powers = unique_and_sorted(PowersList<Ps...>{}).second;
+    using PL = std::decay_t<decltype(final_powers)>;
+    constexpr std::size_t nvars = PL::nvars;
+    constexpr std::size_t nterms = PL::size;
+    constexpr auto &table = detail::PowersTable<PL>::value;
+    constexpr auto maxes = detail::max_degrees(PL{});
+    constexpr unsigned maxdeg = [&]() {
+        unsigned m = 0;
+        for (auto d : maxes)
+        {
+            m = d > m ? d : m;
+        }
+        return m;
+    }();
+    constexpr std::size_t B = detail::monomial_block_size;
+
+    const std::array<const X *, nvars> inputs{xs...};
+    R ladders[nvars][maxdeg + 1][B];
+
+    for (std::size_t start = 0; start < n; start += B)
+    {
+        const std::size_t count = n - start < B ? n - start : B;
+        for (std::size_t v = 0; v < nvars; ++v)
+        {
+            for (std::size_t b = 0; b < count; ++b)
+            {
+                ladders[v][0][b] = 1;
+            }
+            for (unsigned k = 1; k <= maxes[v]; ++k)
+            {
+                for (std::size_t b = 0; b < count; ++b)
+                {
+                    ladders[v][k][b] = k == 1 ? static_cast<R>(inputs[v][start + b])
+                                              : ladders[v][k - 1][b] * static_cast<R>(inputs[v][start + b]);
+                }
+            }
+        }
+
+        R column[B];
+        for (std::size_t j = 0; j < nterms; ++j)
+        {
+            for (std::size_t b = 0; b < count; ++b)
+            {
+                column[b] = 1;
+            }
+            for (std::size_t v = 0; v < nvars; ++v)
+            {
+                if (table[j][v] != 0)
+                {
+                    for (std::size_t b = 0; b < count; ++b)
+                    {
+                        column[b] *= ladders[v][table[j][v]][b];
+                    }
+                }
+            }
+
+            if (layout == MatrixLayout::ColumnMajor)
+            {
+                R *dst = out + j * n + start;
+                for (std::size_t b = 0; b < count; ++b)
+                {
+                    dst[b] = column[b];
+                }
+            }
+            else
+            {
+                R *dst = out + start * nterms + j;
+                for (std::size_t b = 0; b < count; ++b)
+                {
+                    dst[b * nterms] = column[b];
+                }
+            }
+        }
+    }
+}
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_BATCH_HPP
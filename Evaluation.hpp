@@ -0,0 +1,1018 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_EVALUATION_HPP
+#define POLYNOMIAL_EVALUATION_HPP
+
+#include "Powers.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Polynomials
+{
+
+namespace detail
+{
+
+template <class T, class = void>
+struct is_numeric_impl : public std::false_type
+{
+};
+
+template <class T>
+struct is_numeric_impl<
+    T, std::void_t<decltype(T(0)), decltype(std::declval<T>() + std::declval<T>()),
+                   decltype(std::declval<T>() * std::declval<T>())>>
+    : public std::bool_constant<
+          std::is_default_constructible_v<T> && std::is_convertible_v<int, T> &&
+          std::is_convertible_v<decltype(std::declval<T>() + std::declval<T>()), T> &&
+          std::is_convertible_v<decltype(std::declval<T>() * std::declval<T>()), T>>
+{
+};
+
+} // namespace detail
+
+/*
+ * Types usable as Polynomial coefficients and arguments: arithmetic types, and any type that is
+ * default constructible, implicitly constructible from int, and closed under + and *. This admits
+ * SIMD lane vectors such as simd::Vec or std::experimental::simd, so that one evaluation computes
+ * several points at once. Specialize to opt a type in or out explicitly.
+ */
+template <class T>
+struct is_numeric
+    : public std::bool_constant<std::is_arithmetic_v<T> || detail::is_numeric_impl<T>::value>
+{
+};
+
+template <class T>
+constexpr bool is_numeric_v = is_numeric<T>::value;
+
+namespace detail
+{
+
+// Result type of evaluating a polynomial with coefficients T at arguments Xs. For purely
+// arithmetic types this is T, as it always has been; otherwise it is the type of the expression.
+template <class T, class... Xs>
+using eval_result_t = std::conditional_t<
+    (std::is_arithmetic_v<T> && ... && std::is_arithmetic_v<Xs>), T,
+    std::decay_t<decltype((std::declval<Xs>() * ...) * std::declval<T>())>>;
+
+// Coefficient type of p * x; the usual arithmetic conversions for arithmetic types, and the type
+// of the product otherwise.
+template <class T, class U>
+using product_t = typename std::conditional_t<
+    std::is_arithmetic_v<T> && std::is_arithmetic_v<U>, std::common_type<T, U>,
+    std::decay<decltype(std::declval<T>() * std::declval<U>())>>::type;
+
+} // namespace detail
+
+/*
+ * Evaluation strategies, passed as a tag to Polynomial::evaluate.
+ *
+ * Naive evaluates every term independently, exactly as Polynomial::operator() does.
+ *
+ * Horner<Order...> evaluates a recursive (nested) Horner scheme; the outermost variable is
+ * Order[0], the next Order[1], etc. An empty Order means the natural order 0, 1, ..., nvars-1.
+ *
+ * Estrin<Order...> nests variables like Horner<Order...>, but combines the terms of each variable
+ * in a balanced tree: p(x) = q(x) + x^m * r(x), with m a power of two, recursively. The
+ * sub-polynomials are independent, so they evaluate in parallel in the pipeline; the dependent
+ * chain is O(log d) operations long rather than Horner's O(d), at the cost of a few more
+ * multiplications. Prefer it for high degrees where latency, not throughput, is the limit.
+ *
+ * PowerTable computes x^0, ..., x^d once for each variable, where d is the largest exponent of
+ * that variable among the terms, and forms each monomial from table lookups.
+ *
+ * Accumulate<Acc, Strategy> converts the coefficients and arguments to Acc and evaluates with
+ * Strategy in that precision, e.g. float storage with double accumulation.
+ *
+ * CompensatedHorner<Work, Result> runs the Horner scheme in the floating point type Work, tracking
+ * the rounding error of every step with error-free transformations (TwoSum/TwoProd), and returns
+ * the corrected value as Result. The result is about as accurate as Horner in twice the working
+ * precision, so float data can be evaluated to close to double accuracy at float cost.
+ */
+struct Naive
+{
+};
+
+template <std::size_t... Order>
+struct Horner
+{
+};
+
+template <std::size_t... Order>
+struct Estrin
+{
+};
+
+struct PowerTable
+{
+};
+
+template <class Acc, class Strategy = Horner<>>
+struct Accumulate
+{
+};
+
+template <class Work, class Result = Work>
+struct CompensatedHorner
+{
+    static_assert(std::is_floating_point_v<Work>, "Compensated evaluation needs a floating point type");
+};
+
+/*
+ * Number of arithmetic operations performed by an evaluation strategy.
+ */
+struct OpCount
+{
+    std::size_t multiplications;
+    std::size_t additions;
+};
+
+namespace detail
+{
+
+// Type of the coefficients read from C, which is a std::array or any view indexed the same way.
+template <class C>
+using coefficient_t = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<const C &>()[0])>>;
+
+// Type of x^P for an argument X; X itself, except for arguments holding precomputed powers of x.
+template <class X>
+using raised_t = std::decay_t<decltype(raise<1>(std::declval<const X &>()))>;
+
+template <std::size_t... Is, class... Xs, class... Ps, class C>
+constexpr eval_result_t<coefficient_t<C>, raised_t<Xs>...> eval_impl(
+    const C &coeffs, std::index_sequence<Is...>, PowersList<Ps...>, const Xs &...xs) noexcept
+{
+    static_assert(sizeof...(Is) == sizeof...(Ps), "Need one coefficient per term");
+    return ((raise(Ps{}, xs...) * coeffs[Is]) + ...);
+}
+
+// Multiplications done by raise<P>; it splits the exponent in half recursively.
+constexpr std::size_t raise_multiplications(unsigned P) noexcept { return P < 2 ? 0 : P - 1; }
+
+template <class... Ps>
+constexpr OpCount naive_op_count(PowersList<Ps...>) noexcept
+{
+    constexpr std::size_t nvars = PowersList<Ps...>::nvars;
+    constexpr auto table = expand_powers(Ps{}...);
+    std::size_t mults = 0;
+    for (const auto &term : table)
+    {
+        for (auto p : term)
+        {
+            mults += raise_multiplications(p);
+        }
+        mults += nvars;
+    }
+    return OpCount{mults, sizeof...(Ps) - 1};
+}
+
+template <class... Ps>
+constexpr auto max_degrees(PowersList<Ps...>) noexcept
+{
+    return PowersList<Ps...>::max_degrees();
+}
+
+template <std::size_t NVars, std::size_t... Order>
+struct VariableOrder
+{
+    static_assert(sizeof...(Order) == NVars, "Variable ordering must list every variable once");
+
+    static constexpr std::array<std::size_t, NVars> value{Order...};
+
+    static constexpr bool is_permutation() noexcept
+    {
+        for (std::size_t v = 0; v < NVars; ++v)
+        {
+            std::size_t count = 0;
+            for (auto o : value)
+            {
+                count += (o == v);
+            }
+            if (count != 1)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(is_permutation(), "Variable ordering must be a permutation of 0, ..., nvars-1");
+};
+
+template <std::size_t NVars, std::size_t... Is>
+constexpr auto natural_order(std::index_sequence<Is...>) noexcept
+{
+    return VariableOrder<NVars, Is...>{};
+}
+
+template <std::size_t NVars, std::size_t... Order>
+constexpr auto make_order() noexcept
+{
+    if constexpr (sizeof...(Order) == 0)
+    {
+        return natural_order<NVars>(std::make_index_sequence<NVars>());
+    }
+    else
+    {
+        return VariableOrder<NVars, Order...>{};
+    }
+}
+
+template <class PL>
+struct PowersTable;
+
+template <class... Ps>
+struct PowersTable<PowersList<Ps...>>
+{
+    static constexpr auto value = expand_powers(Ps{}...);
+};
+
+/*
+ * Partition the terms Ks of PL into groups sharing the same exponent of variable Var, ordered by
+ * increasing exponent.
+ */
+template <class PL, std::size_t Var, std::size_t... Ks>
+struct ExponentGroups
+{
+    static constexpr std::size_t num_terms = sizeof...(Ks);
+    static constexpr std::array<std::size_t, num_terms> terms{Ks...};
+    static constexpr std::array<unsigned, num_terms> exponents{PowersTable<PL>::value[Ks][Var]...};
+
+    static constexpr std::size_t count_distinct() noexcept
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < num_terms; ++i)
+        {
+            bool seen = false;
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                seen = seen || exponents[j] == exponents[i];
+            }
+            count += !seen;
+        }
+        return count;
+    }
+
+    static constexpr std::size_t count = count_distinct();
+
+    static constexpr auto compute_distinct() noexcept
+    {
+        std::array<unsigned, count> distinct{};
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < num_terms; ++i)
+        {
+            bool seen = false;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                seen = seen || distinct[j] == exponents[i];
+            }
+            if (!seen)
+            {
+                std::size_t k = n++;
+                for (; k > 0 && distinct[k - 1] > exponents[i]; --k)
+                {
+                    distinct[k] = distinct[k - 1];
+                }
+                distinct[k] = exponents[i];
+            }
+        }
+        return distinct;
+    }
+
+    static constexpr std::array<unsigned, count> distinct = compute_distinct();
+
+    static constexpr std::size_t group_size(std::size_t group) noexcept
+    {
+        std::size_t n = 0;
+        for (auto e : exponents)
+        {
+            n += (e == distinct[group]);
+        }
+        return n;
+    }
+
+    static constexpr std::size_t group_member(std::size_t group, std::size_t which) noexcept
+    {
+        for (std::size_t i = 0; i < num_terms; ++i)
+        {
+            if (exponents[i] == distinct[group])
+            {
+                if (which == 0)
+                {
+                    return terms[i];
+                }
+                which -= 1;
+            }
+        }
+        return num_terms;
+    }
+
+    template <std::size_t Group, std::size_t... Is>
+    static constexpr auto members_impl(std::index_sequence<Is...>) noexcept
+    {
+        return std::index_sequence<group_member(Group, Is)...>{};
+    }
+
+    template <std::size_t Group>
+    using members = decltype(members_impl<Group>(std::make_index_sequence<group_size(Group)>()));
+};
+
+/*
+ * A value together with a running estimate of its accumulated rounding error; value + error is
+ * the more accurate result.
+ */
+template <class F>
+struct Compensated
+{
+    F value;
+    F error;
+};
+
+// Error-free transformations: a + b == s + e and a * b == p + e exactly.
+template <class F>
+inline void two_sum(F a, F b, F &s, F &e) noexcept
+{
+    s = a + b;
+    const F z = s - a;
+    e = (a - (s - z)) + (b - z);
+}
+
+/*
+ * The identity for scalars. SIMD types overload it so that the compiler can't contract a later
+ * addition with the multiplication producing x into one fma, which would change the rounding the
+ * error-free transformations below account for.
+ */
+template <class F>
+inline F keep_rounded(F x) noexcept
+{
+    return x;
+}
+
+// Whether std::fma is a hardware instruction for F rather than a call into the math library.
+template <class F>
+constexpr bool fast_fma_v = false;
+
+#ifdef FP_FAST_FMAF
+template <>
+constexpr bool fast_fma_v<float> = true;
+#endif
+
+#ifdef FP_FAST_FMA
+template <>
+constexpr bool fast_fma_v<double> = true;
+#endif
+
+#ifdef FP_FAST_FMAL
+template <>
+constexpr bool fast_fma_v<long double> = true;
+#endif
+
+// The floating point type of F, or of each lane when F is a SIMD vector such as simd::Vec.
+template <class F, class = void>
+struct lane_scalar
+{
+    using type = F;
+};
+
+template <class F>
+struct lane_scalar<F, std::void_t<decltype(std::declval<const F &>()[0])>>
+{
+    using type = std::decay_t<decltype(std::declval<const F &>()[0])>;
+};
+
+/*
+ * Dekker's product using only additions and multiplications: each factor is split into halves
+ * whose partial products are exact (Veltkamp's splitting). Exact unless a * b overflows or
+ * underflows, or a factor is within a factor 2^(digits / 2) of overflowing.
+ */
+template <class F>
+inline void two_prod_dekker(F a, F b, F &p, F &e) noexcept
+{
+    using S = typename lane_scalar<F>::type;
+    const F splitter = F(static_cast<S>((1ull << ((std::numeric_limits<S>::digits + 1) / 2)) + 1));
+    const F ca = splitter * a, cb = splitter * b;
+    const F ahi = ca - (ca - a), bhi = cb - (cb - b);
+    const F alo = a - ahi, blo = b - bhi;
+    p = keep_rounded(a * b);
+    e = ((ahi * bhi - p) + ahi * blo + alo * bhi) + alo * blo;
+}
+
+template <class F>
+inline void two_prod(F a, F b, F &p, F &e) noexcept
+{
+    if constexpr (fast_fma_v<F>)
+    {
+        using std::fma;
+        p = keep_rounded(a * b);
+        e = fma(a, b, -p);
+    }
+    else
+    {
+        two_prod_dekker(a, b, p, e);
+    }
+}
+
+template <class F>
+inline Compensated<F> compensated_add(const Compensated<F> &a, const Compensated<F> &b) noexcept
+{
+    Compensated<F> result;
+    F sigma;
+    two_sum(a.value, b.value, result.value, sigma);
+    result.error = a.error + b.error + sigma;
+    return result;
+}
+
+// Multiply by x^P one factor at a time so that every rounding error is captured.
+template <unsigned P, class F>
+inline Compensated<F> compensated_multiply(Compensated<F> a, F x) noexcept
+{
+    for (unsigned i = 0; i < P; ++i)
+    {
+        F p, pi;
+        two_prod(a.value, x, p, pi);
+        a.error = a.error * x + pi;
+        a.value = p;
+    }
+    return a;
+}
+
+template <class PL, class Order, std::size_t Depth, class Terms, bool Leaf = (Depth == PL::nvars)>
+struct HornerPlan;
+
+template <class PL, class Order, std::size_t Depth, std::size_t K>
+struct HornerPlan<PL, Order, Depth, std::index_sequence<K>, true>
+{
+    template <class C, class Xs>
+    static constexpr auto eval(const C &coeffs, const Xs &) noexcept
+    {
+        return coeffs[K];
+    }
+
+    template <class F, class C, class Xs>
+    static Compensated<F> eval_compensated(const C &coeffs, const Xs &) noexcept
+    {
+        return Compensated<F>{static_cast<F>(coeffs[K]), F(0)};
+    }
+
+    static constexpr OpCount op_count() noexcept { return OpCount{0, 0}; }
+};
+
+/*
+ * Writing x for variable Order[Depth] and e_0 < e_1 < ... for the distinct exponents of x among
+ * the terms Ks, evaluates
+ *
+ *     x^e_0 * (Q_0 + x^(e_1 - e_0) * (Q_1 + x^(e_2 - e_1) * (...)))
+ *
+ * where Q_j is the plan for the terms with exponent e_j, recursing on the next variable.
+ */
+template <class PL, class Order, std::size_t Depth, std::size_t... Ks>
+struct HornerPlan<PL, Order, Depth, std::index_sequence<Ks...>, false>
+{
+    static constexpr std::size_t var = Order::value[Depth];
+    using Groups = ExponentGroups<PL, var, Ks...>;
+
+    template <std::size_t J>
+    using Child = HornerPlan<PL, Order, Depth + 1, typename Groups::template members<J>>;
+
+    template <std::size_t J>
+    static constexpr unsigned gap = Groups::distinct[J + 1] - Groups::distinct[J];
+
+    template <std::size_t J, class C, class Xs>
+    static constexpr auto eval_from(const C &coeffs, const Xs &xs) noexcept
+    {
+        if constexpr (J + 1 == Groups::count)
+        {
+            return Child<J>::eval(coeffs, xs);
+        }
+        else
+        {
+            return Child<J>::eval(coeffs, xs) +
+                   raise<gap<J>>(std::get<var>(xs)) * eval_from<J + 1>(coeffs, xs);
+        }
+    }
+
+    template <class C, class Xs>
+    static constexpr auto eval(const C &coeffs, const Xs &xs) noexcept
+    {
+        if constexpr (Groups::distinct[0] == 0)
+        {
+            return eval_from<0>(coeffs, xs);
+        }
+        else
+        {
+            return raise<Groups::distinct[0]>(std::get<var>(xs)) * eval_from<0>(coeffs, xs);
+        }
+    }
+
+    template <std::size_t J, class F, class C, class Xs>
+    static Compensated<F> eval_compensated_from(const C &coeffs, const Xs &xs) noexcept
+    {
+        if constexpr (J + 1 == Groups::count)
+        {
+            return Child<J>::template eval_compensated<F>(coeffs, xs);
+        }
+        else
+        {
+            const auto rest = eval_compensated_from<J + 1, F>(coeffs, xs);
+            return compensated_add(
+                Child<J>::template eval_compensated<F>(coeffs, xs),
+                compensated_multiply<gap<J>>(rest, std::get<var>(xs)));
+        }
+    }
+
+    template <class F, class C, class Xs>
+    static Compensated<F> eval_compensated(const C &coeffs, const Xs &xs) noexcept
+    {
+        return compensated_multiply<Groups::distinct[0]>(
+            eval_compensated_from<0, F>(coeffs, xs), std::get<var>(xs));
+    }
+
+    template <std::size_t... Js>
+    static constexpr OpCount op_count_impl(std::index_sequence<Js...>) noexcept
+    {
+        OpCount count{0, Groups::count - 1};
+        ((count.multiplications += Child<Js>::op_count().multiplications), ...);
+        ((count.additions += Child<Js>::op_count().additions), ...);
+        for (std::size_t j = 0; j + 1 < Groups::count; ++j)
+        {
+            count.multiplications +=
+                raise_multiplications(Groups::distinct[j + 1] - Groups::distinct[j]) + 1;
+        }
+        if (Groups::distinct[0] != 0)
+        {
+            count.multiplications += raise_multiplications(Groups::distinct[0]) + 1;
+        }
+        return count;
+    }
+
+    static constexpr OpCount op_count() noexcept
+    {
+        return op_count_impl(std::make_index_sequence<Groups::count>());
+    }
+};
+
+template <class PL, std::size_t... Order>
+using horner_plan_t = HornerPlan<
+    PL, decltype(make_order<PL::nvars, Order...>()), 0, std::make_index_sequence<PL::size>>;
+
+template <std::size_t... Order, class... Ps>
+constexpr OpCount horner_op_count(PowersList<Ps...>) noexcept
+{
+    return horner_plan_t<PowersList<Ps...>, Order...>::op_count();
+}
+
+// Largest power of two not greater than n, for n > 0.
+constexpr unsigned estrin_split(unsigned n) noexcept
+{
+    unsigned m = 1;
+    while (m <= n / 2)
+    {
+        m *= 2;
+    }
+    return m;
+}
+
+template <class PL, class Order, std::size_t Depth, class Terms, bool Leaf = (Depth == PL::nvars)>
+struct EstrinPlan;
+
+template <class PL, class Order, std::size_t Depth, std::size_t K>
+struct EstrinPlan<PL, Order, Depth, std::index_sequence<K>, true>
+{
+    template <class C, class Xs>
+    static constexpr auto eval(const C &coeffs, const Xs &) noexcept
+    {
+        return coeffs[K];
+    }
+
+    static constexpr OpCount op_count() noexcept { return OpCount{0, 0}; }
+};
+
+/*
+ * Writing x for variable Order[Depth], e_0 < e_1 < ... for the distinct exponents of x among the
+ * terms Ks and Q_j for the plan of the terms with exponent e_j, evaluates sum_j Q_j * x^e_j by
+ * splitting the groups at x^m, for m the largest power of two not above the exponent range:
+ *
+ *     (groups below x^m) + x^m * (groups from x^m, with exponents reduced by m)
+ *
+ * A common factor of the remaining groups is taken out first, so every split has both halves.
+ */
+template <class PL, class Order, std::size_t Depth, std::size_t... Ks>
+struct EstrinPlan<PL, Order, Depth, std::index_sequence<Ks...>, false>
+{
+    static constexpr std::size_t var = Order::value[Depth];
+    using Groups = ExponentGroups<PL, var, Ks...>;
+
+    template <std::size_t J>
+    using Child = EstrinPlan<PL, Order, Depth + 1, typename Groups::template members<J>>;
+
+    // First group in [Lo, Hi) whose exponent is at least e.
+    static constexpr std::size_t first_at_least(std::size_t lo, std::size_t hi, unsigned e) noexcept
+    {
+        while (lo < hi && Groups::distinct[lo] < e)
+        {
+            ++lo;
+        }
+        return lo;
+    }
+
+    // Sum of Q_j * x^(e_j - Base) over the groups j in [Lo, Hi).
+    template <std::size_t Lo, std::size_t Hi, unsigned Base, class C, class Xs>
+    static constexpr auto eval_range(const C &coeffs, const Xs &xs) noexcept
+    {
+        constexpr unsigned first = Groups::distinct[Lo] - Base;
+        if constexpr (Hi - Lo == 1 && first == 0)
+        {
+            return Child<Lo>::eval(coeffs, xs);
+        }
+        else if constexpr (first != 0)
+        {
+            return raise<first>(std::get<var>(xs)) * eval_range<Lo, Hi, Base + first>(coeffs, xs);
+        }
+        else
+        {
+            constexpr unsigned m = estrin_split(Groups::distinct[Hi - 1] - Base);
+            constexpr std::size_t mid = first_at_least(Lo, Hi, Base + m);
+            return eval_range<Lo, mid, Base>(coeffs, xs) +
+                   raise<m>(std::get<var>(xs)) * eval_range<mid, Hi, Base + m>(coeffs, xs);
+        }
+    }
+
+    template <class C, class Xs>
+    static constexpr auto eval(const C &coeffs, const Xs &xs) noexcept
+    {
+        return eval_range<0, Groups::count, 0>(coeffs, xs);
+    }
+
+    /*
+     * Operations combining the groups, mirroring eval_range. Powers x^m of the splits are squares
+     * of one another and counted once, as the compiler computes them once.
+     */
+    static constexpr OpCount combine_count(
+        std::size_t lo, std::size_t hi, unsigned base, unsigned &max_split) noexcept
+    {
+        const unsigned first = Groups::distinct[lo] - base;
+        if (hi - lo == 1 && first == 0)
+        {
+            return OpCount{0, 0};
+        }
+        else if (first != 0)
+        {
+            const OpCount rest = combine_count(lo, hi, base + first, max_split);
+            return OpCount{rest.multiplications + raise_multiplications(first) + 1, rest.additions};
+        }
+        else
+        {
+            const unsigned m = estrin_split(Groups::distinct[hi - 1] - base);
+            const std::size_t mid = first_at_least(lo, hi, base + m);
+            max_split = m > max_split ? m : max_split;
+            const OpCount low = combine_count(lo, mid, base, max_split);
+            const OpCount high = combine_count(mid, hi, base + m, max_split);
+            return OpCount{
+                low.multiplications + high.multiplications + 1, low.additions + high.additions + 1};
+        }
+    }
+
+    template <std::size_t... Js>
+    static constexpr OpCount op_count_impl(std::index_sequence<Js...>) noexcept
+    {
+        unsigned max_split = 1;
+        OpCount count = combine_count(0, Groups::count, 0, max_split);
+        for (unsigned m = max_split; m > 1; m /= 2)
+        {
+            count.multiplications += 1;
+        }
+        ((count.multiplications += Child<Js>::op_count().multiplications), ...);
+        ((count.additions += Child<Js>::op_count().additions), ...);
+        return count;
+    }
+
+    static constexpr OpCount op_count() noexcept
+    {
+        return op_count_impl(std::make_index_sequence<Groups::count>());
+    }
+};
+
+template <class PL, std::size_t... Order>
+using estrin_plan_t = EstrinPlan<
+    PL, decltype(make_order<PL::nvars, Order...>()), 0, std::make_index_sequence<PL::size>>;
+
+template <std::size_t... Order, class... Ps>
+constexpr OpCount estrin_op_count(PowersList<Ps...>) noexcept
+{
+    return estrin_plan_t<PowersList<Ps...>, Order...>::op_count();
+}
+
+template <unsigned Max, class X>
+constexpr auto power_ladder(const X &x) noexcept
+{
+    using L = decltype(x * x);
+    std::array<L, Max + 1> ladder{};
+    ladder[0] = 1;
+    if constexpr (Max > 0)
+    {
+        ladder[1] = x;
+        for (unsigned k = 2; k <= Max; ++k)
+        {
+            ladder[k] = ladder[k - 1] * x;
+        }
+    }
+    return ladder;
+}
+
+template <class PL, std::size_t... Vs, class... Xs>
+constexpr auto make_power_ladders(std::index_sequence<Vs...>, const Xs &...xs) noexcept
+{
+    constexpr auto maxes = max_degrees(PL{});
+    return std::tuple{power_ladder<maxes[Vs]>(xs)...};
+}
+
+// Multiply acc by the table entries for the non-zero exponents of P, starting at variable V.
+template <std::size_t V, class P, class Acc, class Ladders>
+constexpr auto multiply_table_factors(const Acc &acc, const Ladders &ladders) noexcept
+{
+    if constexpr (V == P::nvars)
+    {
+        return acc;
+    }
+    else if constexpr (P::terms[V] == 0)
+    {
+        return multiply_table_factors<V + 1, P>(acc, ladders);
+    }
+    else
+    {
+        return multiply_table_factors<V + 1, P>(acc * std::get<V>(ladders)[P::terms[V]], ladders);
+    }
+}
+
+template <std::size_t... Is, class C, class... Ps, class Ladders>
+constexpr auto eval_with_table(
+    const C &coeffs, std::index_sequence<Is...>, PowersList<Ps...>, const Ladders &ladders) noexcept
+{
+    return (multiply_table_factors<0, Ps>(coeffs[Is], ladders) + ...);
+}
+
+template <class... Ps>
+constexpr OpCount power_table_op_count(PowersList<Ps...>) noexcept
+{
+    constexpr auto table = expand_powers(Ps{}...);
+    std::size_t mults = 0;
+    for (auto max : max_degrees(PowersList<Ps...>{}))
+    {
+        mults += max < 2 ? 0 : max - 1;
+    }
+    for (const auto &term : table)
+    {
+        for (auto p : term)
+        {
+            mults += (p != 0);
+        }
+    }
+    return OpCount{mults, sizeof...(Ps) - 1};
+}
+
+} // namespace detail
+
+/*
+ * Number of multiplications and additions done by evaluating a polynomial with the terms of
+ * PowersList<Ps...> using the given strategy. Conversions done by Accumulate are not counted.
+ */
+template <class... Ps>
+constexpr OpCount op_count(Naive, PowersList<Ps...>) noexcept
+{
+    return detail::naive_op_count(PowersList<Ps...>{});
+}
+
+template <std::size_t... Order, class... Ps>
+constexpr OpCount op_count(Horner<Order...>, PowersList<Ps...>) noexcept
+{
+    return detail::horner_op_count<Order...>(PowersList<Ps...>{});
+}
+
+template <std::size_t... Order, class... Ps>
+constexpr OpCount op_count(Estrin<Order...>, PowersList<Ps...>) noexcept
+{
+    return detail::estrin_op_count<Order...>(PowersList<Ps...>{});
+}
+
+template <class... Ps>
+constexpr OpCount op_count(PowerTable, PowersList<Ps...>) noexcept
+{
+    return detail::power_table_op_count(PowersList<Ps...>{});
+}
+
+template <class Acc, class Strategy, class... Ps>
+constexpr OpCount op_count(Accumulate<Acc, Strategy>, PowersList<Ps...>) noexcept
+{
+    return op_count(Strategy{}, PowersList<Ps...>{});
+}
+
+namespace detail
+{
+
+template <class T, std::size_t N, class... Ps, class... Xs>
+constexpr eval_result_t<T, Xs...>
+evaluate(Naive, const std::array<T, N> &coeffs, PowersList<Ps...>, const Xs &...xs) noexcept
+{
+    return eval_impl(coeffs, std::make_index_sequence<N>(), PowersList<Ps...>{}, xs...);
+}
+
+template <std::size_t... Order, class T, std::size_t N, class... Ps, class... Xs>
+constexpr eval_result_t<T, Xs...>
+evaluate(Horner<Order...>, const std::array<T, N> &coeffs, PowersList<Ps...>, const Xs &...xs) noexcept
+{
+    static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Wrong number of arguments to evaluate");
+    return horner_plan_t<PowersList<Ps...>, Order...>::eval(coeffs, std::forward_as_tuple(xs...));
+}
+
+template <std::size_t... Order, class T, std::size_t N, class... Ps, class... Xs>
+constexpr eval_result_t<T, Xs...>
+evaluate(Estrin<Order...>, const std::array<T, N> &coeffs, PowersList<Ps...>, const Xs &...xs) noexcept
+{
+    static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Wrong number of arguments to evaluate");
+    return estrin_plan_t<PowersList<Ps...>, Order...>::eval(coeffs, std::forward_as_tuple(xs...));
+}
+
+template <class T, std::size_t N, class... Ps, class... Xs>
+constexpr eval_result_t<T, Xs...>
+evaluate(PowerTable, const std::array<T, N> &coeffs, PowersList<Ps...>, const Xs &...xs) noexcept
+{
+    static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Wrong number of arguments to evaluate");
+    const auto ladders = make_power_ladders<PowersList<Ps...>>(std::index_sequence_for<Xs...>(), xs...);
+    return eval_with_table(coeffs, std::make_index_sequence<N>(), PowersList<Ps...>{}, ladders);
+}
+
+template <class Acc, class Strategy, class T, std::size_t N, class... Ps, class... Xs>
+constexpr Acc evaluate(
+    Accumulate<Acc, Strategy>, const std::array<T, N> &coeffs, PowersList<Ps...>, const Xs &...xs) noexcept
+{
+    std::array<Acc, N> converted{};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        converted[i] = static_cast<Acc>(coeffs[i]);
+    }
+    return evaluate(Strategy{}, converted, PowersList<Ps...>{}, static_cast<Acc>(xs)...);
+}
+
+template <class Work, class Result, class T, std::size_t N, class... Ps, class... Xs>
+Result evaluate(
+    CompensatedHorner<Work, Result>, const std::array<T, N> &coeffs, PowersList<Ps...>,
+    const Xs &...xs) noexcept
+{
+    static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Wrong number of arguments to evaluate");
+    const auto result = horner_plan_t<PowersList<Ps...>>::template eval_compensated<Work>(
+        coeffs, std::make_tuple(static_cast<Work>(xs)...));
+    return static_cast<Result>(result.value) + static_cast<Result>(result.error);
+}
+
+template <class T, T... Is>
+constexpr std::array<T, sizeof...(Is)> sequence_to_array(std::integer_sequence<T, Is...>) noexcept
+{
+    return std::array<T, sizeof...(Is)>{Is...};
+}
+
+/*
+ * Sum of coeffs[Ks] * As * Qs(x) over the terms of a partial derivative, in the form returned by
+ * partials_with_multipliers.
+ */
+template <class C, class Ladders, std::size_t... Ks, unsigned... As, class... Qs>
+constexpr auto sum_partial_terms(
+    const C &coeffs, const Ladders &ladders, std::index_sequence<Ks...>,
+    std::integer_sequence<unsigned, As...>, PowersList<Qs...>) noexcept
+{
+    using T = std::decay_t<decltype(coeffs[0])>;
+    if constexpr (sizeof...(Ks) == 0)
+    {
+        return T(0);
+    }
+    else
+    {
+        return (multiply_table_factors<0, Qs>(coeffs[Ks] * static_cast<T>(As), ladders) + ...);
+    }
+}
+
+template <std::size_t I, class C, class Ladders, class PL>
+constexpr auto partial_from_table(const C &coeffs, const Ladders &ladders, PL) noexcept
+{
+    constexpr auto tup = partials_with_multipliers<I>(PL{});
+    return sum_partial_terms(coeffs, ladders, std::get<0>(tup), std::get<1>(tup), std::get<2>(tup));
+}
+
+template <std::size_t I, std::size_t J, class C, class Ladders, class PL>
+constexpr auto second_partial_from_table(const C &coeffs, const Ladders &ladders, PL) noexcept
+{
+    using T = std::decay_t<decltype(coeffs[0])>;
+    constexpr auto first = partials_with_multipliers<I>(PL{});
+    constexpr auto first_powers = std::get<2>(first);
+    if constexpr (first_powers.size == 0)
+    {
+        return T(0);
+    }
+    else
+    {
+        constexpr auto first_indices = sequence_to_array(std::get<0>(first));
+        constexpr auto first_constants = sequence_to_array(std::get<1>(first));
+        constexpr auto second = partials_with_multipliers<J>(first_powers);
+        constexpr auto second_indices = sequence_to_array(std::get<0>(second));
+
+        // Coefficients of the first partial, filled in only for terms that survive the second.
+        std::array<T, first_powers.size> first_coeffs{};
+        for (auto k : second_indices)
+        {
+            first_coeffs[k] = coeffs[first_indices[k]] * static_cast<T>(first_constants[k]);
+        }
+        return sum_partial_terms(
+            first_coeffs, ladders, std::get<0>(second), std::get<1>(second), std::get<2>(second));
+    }
+}
+
+template <class C, class Ladders, class PL, class Out, std::size_t... Is>
+constexpr void write_gradient(
+    const C &coeffs, const Ladders &ladders, PL, Out &out, std::index_sequence<Is...>) noexcept
+{
+    ((out[1 + Is] = partial_from_table<Is>(coeffs, ladders, PL{})), ...);
+}
+
+template <std::size_t I, std::size_t J, class C, class Ladders, class PL, class Out>
+constexpr void write_hessian_entry(const C &coeffs, const Ladders &ladders, PL, Out &out) noexcept
+{
+    constexpr std::size_t n = PL::nvars;
+    if constexpr (I <= J)
+    {
+        out[1 + n + I * n + J] = second_partial_from_table<I, J>(coeffs, ladders, PL{});
+        out[1 + n + J * n + I] = out[1 + n + I * n + J];
+    }
+}
+
+template <std::size_t I, class C, class Ladders, class PL, class Out, std::size_t... Js>
+constexpr void write_hessian_row(
+    const C &coeffs, const Ladders &ladders, PL, Out &out, std::index_sequence<Js...>) noexcept
+{
+    (write_hessian_entry<I, Js>(coeffs, ladders, PL{}, out), ...);
+}
+
+template <class C, class Ladders, class PL, class Out, std::size_t... Is>
+constexpr void write_hessian(
+    const C &coeffs, const Ladders &ladders, PL, Out &out, std::index_sequence<Is...> seq) noexcept
+{
+    (write_hessian_row<Is>(coeffs, ladders, PL{}, out, seq), ...);
+}
+
+/*
+ * Write p(x) to out[0] and the gradient of p to out[1], ..., out[nvars], sharing one set of
+ * power ladders (see PowerTable) between all of them.
+ */
+template <class T, std::size_t N, class... Ps, class Out, class... Xs>
+constexpr void value_and_gradient(
+    const std::array<T, N> &coeffs, PowersList<Ps...>, Out &out, const Xs &...xs) noexcept
+{
+    using PL = PowersList<Ps...>;
+    static_assert(sizeof...(Xs) == PL::nvars, "Wrong number of arguments to value_and_gradient");
+    const auto ladders = make_power_ladders<PL>(std::index_sequence_for<Xs...>(), xs...);
+    out[0] = eval_with_table(coeffs, std::make_index_sequence<N>(), PL{}, ladders);
+    write_gradient(coeffs, ladders, PL{}, out, std::index_sequence_for<Xs...>());
+}
+
+/*
+ * As value_and_gradient, additionally writing the Hessian in row-major order to
+ * out[nvars + 1], ..., out[nvars + nvars * nvars].
+ */
+template <class T, std::size_t N, class... Ps, class Out, class... Xs>
+constexpr void value_gradient_hessian(
+    const std::array<T, N> &coeffs, PowersList<Ps...>, Out &out, const Xs &...xs) noexcept
+{
+    using PL = PowersList<Ps...>;
+    static_assert(sizeof...(Xs) == PL::nvars, "Wrong number of arguments to value_gradient_hessian");
+    const auto ladders = make_power_ladders<PL>(std::index_sequence_for<Xs...>(), xs...);
+    out[0] = eval_with_table(coeffs, std::make_index_sequence<N>(), PL{}, ladders);
+    write_gradient(coeffs, ladders, PL{}, out, std::index_sequence_for<Xs...>());
+    write_hessian(coeffs, ladders, PL{}, out, std::index_sequence_for<Xs...>());
+}
+
+} // namespace detail
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_EVALUATION_HPP
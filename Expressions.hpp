@@ -0,0 +1,356 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_EXPRESSIONS_HPP
+#define POLYNOMIAL_EXPRESSIONS_HPP
+
+#include "Polynomial.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Polynomials
+{
+
+/*
+ * Lazy polynomial arithmetic. Wrapping a polynomial with lazy(p) makes +, - and * (with other
+ * polynomials, lazy expressions or numbers) build lightweight expression nodes instead of
+ * Polynomials:
+ *
+ *     const auto e = a * lazy(p) + b * lazy(q) * r - s;
+ *     const double v = e(x, y);          // evaluates p, q, r, s at (x, y); nothing is expanded
+ *     const auto poly = e.materialize(); // one canonicalization of all the summed terms
+ *
+ * Evaluating an expression at a point combines the values of its operands, so expanded products
+ * are never formed; cost() gives the operations this takes, to compare with the cost of the
+ * materialized polynomial when it will be evaluated many times. Materializing concatenates the
+ * terms of a whole chain of sums and scalings and canonicalizes them once, rather than at every
+ * operator+; only the operands of a product are canonicalized before they are multiplied.
+ *
+ * Leaves refer to their polynomials, which must outlive the expression; temporary polynomials are
+ * rejected as operands.
+ */
+template <class E>
+struct LazyExpression
+{
+    // The expression as a Polynomial.
+    constexpr auto materialize() const noexcept
+    {
+        const E &self = static_cast<const E &>(*this);
+        return make_poly(self.coeffs(), typename E::powers{});
+    }
+
+    // Materialize on assignment to a Polynomial with the canonical terms of the expression.
+    template <class T, class... Qs>
+    constexpr operator Polynomial<T, Qs...>() const noexcept
+    {
+        static_assert(
+            std::is_same_v<
+                PowersList<Qs...>, std::decay_t<decltype(unique_and_sorted(typename E::powers{}).second)>>,
+            "Expression has different terms than the Polynomial it is assigned to");
+        const auto p = materialize();
+        std::array<T, sizeof...(Qs)> cs{0};
+        for (std::size_t i = 0; i < sizeof...(Qs); ++i)
+        {
+            cs[i] = static_cast<T>(p.coeffs()[i]);
+        }
+        return make_poly(cs, PowersList<Qs...>{});
+    }
+};
+
+template <class T, class... Ps>
+class LazyPolynomial : public LazyExpression<LazyPolynomial<T, Ps...>>
+{
+    const Polynomial<T, Ps...> *m_p;
+
+  public:
+    using powers = PowersList<Ps...>;
+
+    constexpr explicit LazyPolynomial(const Polynomial<T, Ps...> &p) noexcept : m_p{&p} {}
+
+    constexpr const auto &coeffs() const noexcept { return m_p->coeffs(); }
+
+    template <class... Xs>
+    constexpr auto operator()(const Xs &...xs) const noexcept
+    {
+        return (*m_p)(xs...);
+    }
+
+    static constexpr OpCount cost() noexcept { return op_count(Naive{}, powers{}); }
+};
+
+template <class L, class R>
+class LazySum : public LazyExpression<LazySum<L, R>>
+{
+    L m_l;
+    R m_r;
+
+  public:
+    using powers = decltype(typename L::powers{} + typename R::powers{});
+
+    constexpr LazySum(const L &l, const R &r) noexcept : m_l{l}, m_r{r} {}
+
+    // The coefficients of both operands, in the order of powers; nothing is collected yet.
+    constexpr auto coeffs() const noexcept
+    {
+        const auto &lcs = m_l.coeffs();
+        const auto &rcs = m_r.coeffs();
+        using C = std::common_type_t<std::decay_t<decltype(lcs[0])>, std::decay_t<decltype(rcs[0])>>;
+        std::array<C, powers::size> cs{0};
+        for (std::size_t i = 0; i < lcs.size(); ++i)
+        {
+            cs[i] = lcs[i];
+        }
+        for (std::size_t i = 0; i < rcs.size(); ++i)
+        {
+            cs[lcs.size() + i] = rcs[i];
+        }
+        return cs;
+    }
+
+    template <class... Xs>
+    constexpr auto operator()(const Xs &...xs) const noexcept
+    {
+        return m_l(xs...) + m_r(xs...);
+    }
+
+    static constexpr OpCount cost() noexcept
+    {
+        constexpr OpCount l = L::cost(), r = R::cost();
+        return OpCount{l.multiplications + r.multiplications, l.additions + r.additions + 1};
+    }
+};
+
+/*
+ * The operands are materialized and multiplied (collecting each product into its canonical term)
+ * only when the coefficients are needed.
+ */
+template <class L, class R>
+class LazyProduct : public LazyExpression<LazyProduct<L, R>>
+{
+    L m_l;
+    R m_r;
+
+    template <class T, class... Ps>
+    static PowersList<Ps...> powers_of(const Polynomial<T, Ps...> &);
+
+  public:
+    using powers = decltype(powers_of(std::declval<L>().materialize() * std::declval<R>().materialize()));
+
+    constexpr LazyProduct(const L &l, const R &r) noexcept : m_l{l}, m_r{r} {}
+
+    constexpr auto coeffs() const noexcept { return (m_l.materialize() * m_r.materialize()).coeffs(); }
+
+    template <class... Xs>
+    constexpr auto operator()(const Xs &...xs) const noexcept
+    {
+        return m_l(xs...) * m_r(xs...);
+    }
+
+    static constexpr OpCount cost() noexcept
+    {
+        constexpr OpCount l = L::cost(), r = R::cost();
+        return OpCount{l.multiplications + r.multiplications + 1, l.additions + r.additions};
+    }
+};
+
+template <class E, class U>
+class LazyScaled : public LazyExpression<LazyScaled<E, U>>
+{
+    E m_e;
+    U m_scale;
+
+  public:
+    using powers = typename E::powers;
+
+    constexpr LazyScaled(const E &e, const U &scale) noexcept : m_e{e}, m_scale{scale} {}
+
+    constexpr auto coeffs() const noexcept
+    {
+        const auto &ecs = m_e.coeffs();
+        std::array<detail::product_t<std::decay_t<decltype(ecs[0])>, U>, powers::size> cs{0};
+        for (std::size_t i = 0; i < powers::size; ++i)
+        {
+            cs[i] = ecs[i] * m_scale;
+        }
+        return cs;
+    }
+
+    template <class... Xs>
+    constexpr auto operator()(const Xs &...xs) const noexcept
+    {
+        return m_e(xs...) * m_scale;
+    }
+
+    static constexpr OpCount cost() noexcept
+    {
+        constexpr OpCount e = E::cost();
+        return OpCount{e.multiplications + 1, e.additions};
+    }
+};
+
+// Negation is folded into the enclosing sum, so it is not counted as an operation.
+template <class E>
+class LazyNegation : public LazyExpression<LazyNegation<E>>
+{
+    E m_e;
+
+  public:
+    using powers = typename E::powers;
+
+    constexpr explicit LazyNegation(const E &e) noexcept : m_e{e} {}
+
+    constexpr auto coeffs() const noexcept
+    {
+        auto cs = m_e.coeffs();
+        for (auto &c : cs)
+        {
+            c = -c;
+        }
+        return cs;
+    }
+
+    template <class... Xs>
+    constexpr auto operator()(const Xs &...xs) const noexcept
+    {
+        return -m_e(xs...);
+    }
+
+    static constexpr OpCount cost() noexcept { return E::cost(); }
+};
+
+template <class T, class... Ps>
+constexpr LazyPolynomial<T, Ps...> lazy(const Polynomial<T, Ps...> &p) noexcept
+{
+    return LazyPolynomial<T, Ps...>(p);
+}
+
+// A leaf refers to its polynomial, so it cannot be made from a temporary.
+template <class T, class... Ps>
+void lazy(const Polynomial<T, Ps...> &&) = delete;
+
+namespace detail
+{
+
+template <class E>
+constexpr bool is_lazy_v = std::is_base_of_v<LazyExpression<E>, E>;
+
+template <class P>
+struct is_polynomial : public std::false_type
+{
+};
+
+template <class T, class... Ps>
+struct is_polynomial<Polynomial<T, Ps...>> : public std::true_type
+{
+};
+
+// Operand pairs handled lazily: at least one lazy expression, the other a polynomial or expression.
+template <class L, class R>
+constexpr bool lazy_operands_v = (is_lazy_v<L> || is_lazy_v<R>) &&
+                                 (is_lazy_v<L> || is_polynomial<L>::value) &&
+                                 (is_lazy_v<R> || is_polynomial<R>::value);
+
+template <class E>
+constexpr const E &as_lazy(const E &e) noexcept
+{
+    return e;
+}
+
+template <class T, class... Ps>
+constexpr LazyPolynomial<T, Ps...> as_lazy(const Polynomial<T, Ps...> &p) noexcept
+{
+    return LazyPolynomial<T, Ps...>(p);
+}
+
+template <class E>
+using lazy_t = std::decay_t<decltype(as_lazy(std::declval<const E &>()))>;
+
+} // namespace detail
+
+template <class L, class R>
+constexpr std::enable_if_t<detail::lazy_operands_v<L, R>, LazySum<detail::lazy_t<L>, detail::lazy_t<R>>>
+operator+(const L &l, const R &r) noexcept
+{
+    return LazySum<detail::lazy_t<L>, detail::lazy_t<R>>(detail::as_lazy(l), detail::as_lazy(r));
+}
+
+template <class L, class R>
+constexpr std::enable_if_t<
+    detail::lazy_operands_v<L, R>, LazySum<detail::lazy_t<L>, LazyNegation<detail::lazy_t<R>>>>
+operator-(const L &l, const R &r) noexcept
+{
+    using Negated = LazyNegation<detail::lazy_t<R>>;
+    return LazySum<detail::lazy_t<L>, Negated>(detail::as_lazy(l), Negated(detail::as_lazy(r)));
+}
+
+template <class L, class R>
+constexpr std::enable_if_t<detail::lazy_operands_v<L, R>, LazyProduct<detail::lazy_t<L>, detail::lazy_t<R>>>
+operator*(const L &l, const R &r) noexcept
+{
+    return LazyProduct<detail::lazy_t<L>, detail::lazy_t<R>>(detail::as_lazy(l), detail::as_lazy(r));
+}
+
+/*
+ * Polynomial operands are held by reference like lazy(p), so temporaries are rejected: an rvalue
+ * binds to these in preference to the overloads above.
+ */
+template <class E, class T, class... Ps>
+std::enable_if_t<detail::is_lazy_v<E>> operator+(const E &, const Polynomial<T, Ps...> &&) = delete;
+
+template <class T, class... Ps, class E>
+std::enable_if_t<detail::is_lazy_v<E>> operator+(const Polynomial<T, Ps...> &&, const E &) = delete;
+
+template <class E, class T, class... Ps>
+std::enable_if_t<detail::is_lazy_v<E>> operator-(const E &, const Polynomial<T, Ps...> &&) = delete;
+
+template <class T, class... Ps, class E>
+std::enable_if_t<detail::is_lazy_v<E>> operator-(const Polynomial<T, Ps...> &&, const E &) = delete;
+
+template <class E, class T, class... Ps>
+std::enable_if_t<detail::is_lazy_v<E>> operator*(const E &, const Polynomial<T, Ps...> &&) = delete;
+
+template <class T, class... Ps, class E>
+std::enable_if_t<detail::is_lazy_v<E>> operator*(const Polynomial<T, Ps...> &&, const E &) = delete;
+
+template <class E>
+constexpr std::enable_if_t<detail::is_lazy_v<E>, LazyNegation<E>> operator-(const E &e) noexcept
+{
+    return LazyNegation<E>(e);
+}
+
+template <class E, class U>
+constexpr std::enable_if_t<detail::is_lazy_v<E> && is_numeric_v<U>, LazyScaled<E, U>>
+operator*(const E &e, const U &x) noexcept
+{
+    return LazyScaled<E, U>(e, x);
+}
+
+template <class U, class E>
+constexpr std::enable_if_t<detail::is_lazy_v<E> && is_numeric_v<U>, LazyScaled<E, U>>
+operator*(const U &x, const E &e) noexcept
+{
+    return LazyScaled<E, U>(e, x);
+}
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_EXPRESSIONS_HPP
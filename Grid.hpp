@@ -0,0 +1,182 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_GRID_HPP
+#define POLYNOMIAL_GRID_HPP
+
+#include "Polynomial.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Polynomials
+{
+
+namespace detail
+{
+
+/*
+ * Layout of the dense coefficient tensor C[e_0][e_1]...[e_{d-1}] of a PowersList, where e_v runs
+ * over 0, ..., max degree of variable v. offsets[j] is the position of term j in the tensor.
+ */
+template <class PL>
+struct GridLayout
+{
+    static constexpr std::size_t nvars = PL::nvars;
+    static constexpr auto degrees = max_degrees(PL{});
+
+    static constexpr std::size_t dense_size = []() {
+        std::size_t size = 1;
+        for (auto d : degrees)
+        {
+            size *= d + 1;
+        }
+        return size;
+    }();
+
+    static constexpr std::array<std::size_t, PL::size> offsets = []() {
+        std::array<std::size_t, PL::size> result{};
+        const auto &table = PowersTable<PL>::value;
+        for (std::size_t j = 0; j < PL::size; ++j)
+        {
+            for (std::size_t v = 0; v < nvars; ++v)
+            {
+                result[j] = result[j] * (degrees[v] + 1) + table[j][v];
+            }
+        }
+        return result;
+    }();
+};
+
+// Fill vander (npoints x (degree + 1), row-major) with the powers of each grid point.
+template <class C, class Grid>
+void grid_powers(std::vector<C> &vander, const Grid &grid, unsigned degree)
+{
+    const std::size_t npoints = std::size(grid);
+    const auto *points = std::data(grid);
+    vander.resize(npoints * (degree + 1));
+    for (std::size_t q = 0; q < npoints; ++q)
+    {
+        C *row = vander.data() + q * (degree + 1);
+        row[0] = C(1);
+        for (unsigned e = 1; e <= degree; ++e)
+        {
+            row[e] = row[e - 1] * static_cast<C>(points[q]);
+        }
+    }
+}
+
+/*
+ * Contract the middle index of src[outer][nterms][inner] against vander[npoints][nterms], giving
+ * dst[outer][npoints][inner]. The innermost loop runs over contiguous memory in both arrays.
+ */
+template <class C>
+void contract_dimension(
+    const C *src, C *dst, std::size_t outer, std::size_t nterms, std::size_t inner, const C *vander,
+    std::size_t npoints) noexcept
+{
+    for (std::size_t o = 0; o < outer; ++o)
+    {
+        for (std::size_t q = 0; q < npoints; ++q)
+        {
+            C *d = dst + (o * npoints + q) * inner;
+            for (std::size_t i = 0; i < inner; ++i)
+            {
+                d[i] = C(0);
+            }
+            for (std::size_t e = 0; e < nterms; ++e)
+            {
+                const C v = vander[q * nterms + e];
+                const C *s = src + (o * nterms + e) * inner;
+                for (std::size_t i = 0; i < inner; ++i)
+                {
+                    d[i] = d[i] + v * s[i];
+                }
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+/*
+ * Evaluate p at every point of the tensor-product grid xs x ys x ..., given one container (with
+ * std::data and std::size) of coordinates per variable. out[(i * ny + j) * nz + k] = p(xs[i], ys[j],
+ * zs[k]), i.e. row-major with the last variable varying fastest.
+ *
+ * The coefficients are scattered into a dense tensor over the exponents of each variable (offsets
+ * computed at compile time), which is then contracted against the powers of one grid at a time
+ * (sum factorization). With n >= m points per direction and degree m in d variables, this costs
+ * O(m n^d) operations rather than O(m^d n^d) for pointwise evaluation.
+ */
+template <class T, class... Ps, class R, class... Grids>
+void evaluate_on_grid(const Polynomial<T, Ps...> &p, R *out, const Grids &...grids)
+{
+    using PL = PowersList<Ps...>;
+    static_assert(sizeof...(Grids) == PL::nvars, "Need one grid per polynomial variable");
+    using C = std::common_type_t<T, std::decay_t<decltype(*std::data(grids))>...>;
+    using Layout = detail::GridLayout<PL>;
+    constexpr std::size_t nvars = PL::nvars;
+
+    const std::array<std::size_t, nvars> npoints{static_cast<std::size_t>(std::size(grids))...};
+    std::array<std::vector<C>, nvars> vanders;
+    {
+        std::size_t v = 0;
+        ((detail::grid_powers(vanders[v], grids, Layout::degrees[v]), ++v), ...);
+    }
+
+    std::size_t scratch = Layout::dense_size;
+    std::size_t current = Layout::dense_size;
+    for (std::size_t v = 0; v < nvars; ++v)
+    {
+        current = current / (Layout::degrees[v] + 1) * npoints[v];
+        scratch = current > scratch ? current : scratch;
+    }
+
+    std::vector<C> src(scratch, C(0)), dst(scratch);
+    for (std::size_t j = 0; j < sizeof...(Ps); ++j)
+    {
+        src[Layout::offsets[j]] = static_cast<C>(p.coeffs()[j]);
+    }
+
+    // Contract variable v: indices before v are grid points, indices after v are still exponents.
+    std::size_t outer = 1, inner = Layout::dense_size;
+    for (std::size_t v = 0; v < nvars; ++v)
+    {
+        const std::size_t nterms = Layout::degrees[v] + 1;
+        inner /= nterms;
+        detail::contract_dimension(
+            src.data(), dst.data(), outer, nterms, inner, vanders[v].data(), npoints[v]);
+        outer *= npoints[v];
+        src.swap(dst);
+    }
+
+    for (std::size_t i = 0; i < outer; ++i)
+    {
+        out[i] = static_cast<R>(src[i]);
+    }
+}
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_GRID_HPP
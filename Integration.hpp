@@ -0,0 +1,149 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_INTEGRATION_HPP
+#define POLYNOMIAL_INTEGRATION_HPP
+
+#include "Polynomial.hpp"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace Polynomials
+{
+
+namespace detail
+{
+
+// Integral of x_0^e_0 ... x_{d-1}^e_{d-1} over [-1, 1]^d.
+template <std::size_t D>
+struct ReferenceHypercube
+{
+    static constexpr std::size_t dimension = D;
+
+    static constexpr double monomial_integral(const std::array<unsigned, D> &exponents) noexcept
+    {
+        double result = 1;
+        for (auto e : exponents)
+        {
+            result *= e % 2 == 0 ? 2.0 / (e + 1) : 0.0;
+        }
+        return result;
+    }
+};
+
+/*
+ * Integral of x_0^e_0 ... x_{d-1}^e_{d-1} over the unit simplex, e_0! ... e_{d-1}! / (e_0 + ... +
+ * e_{d-1} + d)!. The factorials are interleaved so that intermediate values stay near 1.
+ */
+template <std::size_t D>
+struct ReferenceSimplex
+{
+    static constexpr std::size_t dimension = D;
+
+    static constexpr double monomial_integral(const std::array<unsigned, D> &exponents) noexcept
+    {
+        double result = 1;
+        unsigned k = 0;
+        for (auto e : exponents)
+        {
+            for (unsigned j = 1; j <= e; ++j)
+            {
+                result *= static_cast<double>(j) / ++k;
+            }
+        }
+        for (std::size_t i = 0; i < D; ++i)
+        {
+            result /= ++k;
+        }
+        return result;
+    }
+};
+
+} // namespace detail
+
+/*
+ * Reference domains for integrate. Each provides its dimension and the exact integral of a single
+ * monomial with the given exponents; any other domain with the same interface may be used.
+ *
+ * ReferenceInterval, ReferenceSquare and ReferenceCube are [-1, 1]^d, and ReferenceTriangle and
+ * ReferenceTetrahedron are the unit simplices {x_i >= 0, x_0 + ... + x_{d-1} <= 1}.
+ */
+struct ReferenceInterval : public detail::ReferenceHypercube<1>
+{
+};
+
+struct ReferenceSquare : public detail::ReferenceHypercube<2>
+{
+};
+
+struct ReferenceCube : public detail::ReferenceHypercube<3>
+{
+};
+
+struct ReferenceTriangle : public detail::ReferenceSimplex<2>
+{
+};
+
+struct ReferenceTetrahedron : public detail::ReferenceSimplex<3>
+{
+};
+
+namespace detail
+{
+
+// Integrals over Domain of each monomial of PL, in order.
+template <class Domain, class PL>
+struct IntegrationWeights
+{
+    static_assert(Domain::dimension == PL::nvars, "Domain dimension does not match number of variables");
+
+    static constexpr std::array<double, PL::size> value = []() {
+        std::array<double, PL::size> weights{};
+        const auto &table = PowersTable<PL>::value;
+        for (std::size_t j = 0; j < PL::size; ++j)
+        {
+            weights[j] = Domain::monomial_integral(table[j]);
+        }
+        return weights;
+    }();
+};
+
+} // namespace detail
+
+/*
+ * Exact integral of p over Domain: the dot product of p's coefficients with a table of monomial
+ * integrals computed at compile time from the exponents of p.
+ */
+template <class Domain, class T, class... Ps>
+constexpr detail::product_t<T, double> integrate(const Polynomial<T, Ps...> &p) noexcept
+{
+    constexpr auto &weights = detail::IntegrationWeights<Domain, PowersList<Ps...>>::value;
+    detail::product_t<T, double> result(0);
+    for (std::size_t j = 0; j < sizeof...(Ps); ++j)
+    {
+        result = result + p.coeffs()[j] * weights[j];
+    }
+    return result;
+}
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_INTEGRATION_HPP
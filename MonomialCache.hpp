@@ -0,0 +1,183 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_MONOMIAL_CACHE_HPP
+#define POLYNOMIAL_MONOMIAL_CACHE_HPP
+
+#include "Polynomial.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Polynomials
+{
+
+template <class MaxPowers, class T = double>
+class MonomialCache;
+
+/*
+ * Every monomial x0^k0 * x1^k1 * ... at one point with each exponent kv at most the corresponding
+ * exponent of MaxPowers, computed once with one multiplication per monomial. Any polynomial whose
+ * terms fit inside the bound then evaluates as a dot product of its coefficients with entries of
+ * the cache, so a family of polynomials (basis functions, their partials, a geometry map) evaluated
+ * at the same point shares a single set of powers:
+ *
+ *     const auto cache = make_monomial_cache<monomial_bound_t<Basis, Gradients>>(x, y);
+ *     const double value = cache(phi), dx = cache(dphi_dx);
+ */
+template <unsigned... Maxes, class T>
+class MonomialCache<Powers<Maxes...>, T>
+{
+    static constexpr std::size_t nvars = sizeof...(Maxes);
+    static constexpr std::array<unsigned, nvars> maxes{Maxes...};
+
+    // Stride of variable v in the table; the last variable is contiguous.
+    static constexpr std::array<std::size_t, nvars> strides = []() {
+        std::array<std::size_t, nvars> s{};
+        std::size_t stride = 1;
+        for (std::size_t v = nvars; v-- > 0;)
+        {
+            s[v] = stride;
+            stride *= maxes[v] + 1;
+        }
+        return s;
+    }();
+
+    std::array<T, ((Maxes + 1) * ...)> m_values;
+
+    template <class P>
+    static constexpr std::size_t index() noexcept
+    {
+        std::size_t i = 0;
+        for (std::size_t v = 0; v < nvars; ++v)
+        {
+            i += P::terms[v] * strides[v];
+        }
+        return i;
+    }
+
+    template <class P>
+    static constexpr bool fits() noexcept
+    {
+        for (std::size_t v = 0; v < nvars; ++v)
+        {
+            if (P::terms[v] > maxes[v])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class C, class... Ps, std::size_t... Is>
+    constexpr auto dot(const C &coeffs, PowersList<Ps...>, std::index_sequence<Is...>) const noexcept
+    {
+        return ((m_values[index<Ps>()] * coeffs[Is]) + ...);
+    }
+
+  public:
+    static constexpr std::size_t size = ((Maxes + 1) * ...);
+
+    template <class... Xs>
+    constexpr explicit MonomialCache(const Xs &...xs) noexcept : m_values{}
+    {
+        static_assert(sizeof...(Xs) == nvars, "MonomialCache needs one coordinate per variable");
+        const std::array<T, nvars> point{static_cast<T>(xs)...};
+
+        // Fill the powers of the last variable, then extend the table one variable at a time:
+        // the block for exponent k of variable v is the block for k - 1 times x_v.
+        m_values[0] = 1;
+        for (std::size_t v = nvars; v-- > 0;)
+        {
+            for (unsigned k = 1; k <= maxes[v]; ++k)
+            {
+                for (std::size_t j = 0; j < strides[v]; ++j)
+                {
+                    m_values[k * strides[v] + j] = m_values[(k - 1) * strides[v] + j] * point[v];
+                }
+            }
+        }
+    }
+
+    // The value of the monomial with exponents Ks... at the cached point.
+    template <unsigned... Ks>
+    constexpr T operator[](Powers<Ks...>) const noexcept
+    {
+        static_assert(fits<Powers<Ks...>>(), "Monomial is outside the bounds of the cache");
+        return m_values[index<Powers<Ks...>>()];
+    }
+
+    // The value of p at the cached point, as a dot product of its coefficients with the cache.
+    template <class U, class... Ps>
+    constexpr detail::eval_result_t<U, T> operator()(const Polynomial<U, Ps...> &p) const noexcept
+    {
+        static_assert(
+            ((Ps::nvars == nvars) && ...), "Polynomial has a different number of variables than the cache");
+        static_assert((fits<Ps>() && ...), "Polynomial has terms outside the bounds of the cache");
+        return dot(p.coeffs(), PowersList<Ps...>{}, std::make_index_sequence<sizeof...(Ps)>());
+    }
+};
+
+namespace detail
+{
+
+template <class... Polys>
+constexpr auto monomial_bound_degrees() noexcept
+{
+    constexpr std::size_t nvars = std::tuple_element_t<0, std::tuple<Polys...>>::max_degrees().size();
+    std::array<unsigned, nvars> maxes{};
+    for (const auto &degrees : {Polys::max_degrees()...})
+    {
+        for (std::size_t v = 0; v < nvars; ++v)
+        {
+            maxes[v] = degrees[v] > maxes[v] ? degrees[v] : maxes[v];
+        }
+    }
+    return maxes;
+}
+
+template <class... Polys, std::size_t... Vs>
+constexpr auto monomial_bound_impl(std::index_sequence<Vs...>) noexcept
+{
+    constexpr auto maxes = monomial_bound_degrees<Polys...>();
+    return Powers<maxes[Vs]...>{};
+}
+
+} // namespace detail
+
+/*
+ * The smallest MaxPowers bound covering every term of the given Polynomial or PowersList types,
+ * which must all have the same number of variables.
+ */
+template <class Poly, class... Polys>
+using monomial_bound_t = decltype(detail::monomial_bound_impl<Poly, Polys...>(
+    std::make_index_sequence<Poly::max_degrees().size()>()));
+
+// A MonomialCache at the point xs..., with the common type of the coordinates.
+template <class MaxPowers, class... Xs>
+constexpr auto make_monomial_cache(const Xs &...xs) noexcept
+{
+    return MonomialCache<MaxPowers, std::common_type_t<Xs...>>(xs...);
+}
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_MONOMIAL_CACHE_HPP
@@ -0,0 +1,227 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_PARALLEL_HPP
+#define POLYNOMIAL_PARALLEL_HPP
+
+#include "Batch.hpp"
+#include "Polynomial.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Polynomials
+{
+
+/*
+ * A fixed-size pool of worker threads executing one parallel_for at a time. Each call splits its
+ * tasks into contiguous runs, one per thread; a thread works through its own run from the front
+ * and, once that is empty, steals from the back of other threads' runs. The calling thread takes
+ * part in the work, so a pool of size 1 runs everything inline.
+ */
+class ThreadPool
+{
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    std::size_t m_size;
+    std::unique_ptr<Queue[]> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::size_t m_generation = 0;
+    bool m_stop = false;
+
+    std::function<void(std::size_t)> m_body;
+    std::atomic<std::size_t> m_remaining{0};
+
+    bool pop_own(std::size_t self, std::size_t &task)
+    {
+        std::lock_guard<std::mutex> lock(m_queues[self].mutex);
+        if (m_queues[self].tasks.empty())
+        {
+            return false;
+        }
+        task = m_queues[self].tasks.front();
+        m_queues[self].tasks.pop_front();
+        return true;
+    }
+
+    bool steal(std::size_t self, std::size_t &task)
+    {
+        for (std::size_t offset = 1; offset < m_size; ++offset)
+        {
+            Queue &victim = m_queues[(self + offset) % m_size];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run_tasks(std::size_t self)
+    {
+        std::size_t task;
+        while (pop_own(self, task) || steal(self, task))
+        {
+            m_body(task);
+            if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done.notify_all();
+            }
+        }
+    }
+
+    void worker_loop(std::size_t self)
+    {
+        std::size_t seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop)
+                {
+                    return;
+                }
+                seen = m_generation;
+            }
+            run_tasks(self);
+        }
+    }
+
+  public:
+    explicit ThreadPool(std::size_t nthreads = std::thread::hardware_concurrency())
+        : m_size{nthreads == 0 ? 1 : nthreads}, m_queues{new Queue[m_size]}
+    {
+        m_threads.reserve(m_size - 1);
+        for (std::size_t i = 1; i < m_size; ++i)
+        {
+            m_threads.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Number of threads taking part in parallel_for, including the caller.
+    std::size_t size() const noexcept { return m_size; }
+
+    /*
+     * Call body(i) for every i in [0, ntasks), returning once all calls have finished. body must
+     * not throw.
+     */
+    template <class F>
+    void parallel_for(std::size_t ntasks, F &&body)
+    {
+        if (ntasks == 0)
+        {
+            return;
+        }
+        if (m_size == 1 || ntasks == 1)
+        {
+            for (std::size_t i = 0; i < ntasks; ++i)
+            {
+                body(i);
+            }
+            return;
+        }
+
+        m_body = std::ref(body);
+        m_remaining.store(ntasks, std::memory_order_relaxed);
+        for (std::size_t w = 0; w < m_size; ++w)
+        {
+            std::lock_guard<std::mutex> lock(m_queues[w].mutex);
+            for (std::size_t i = w * ntasks / m_size; i < (w + 1) * ntasks / m_size; ++i)
+            {
+                m_queues[w].tasks.push_back(i);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_generation += 1;
+        }
+        m_wake.notify_all();
+
+        run_tasks(0);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&] { return m_remaining.load(std::memory_order_acquire) == 0; });
+    }
+};
+
+namespace detail
+{
+
+// Points per parallel task; large enough to amortize scheduling, small enough to balance load
+// and keep each task's inputs and outputs within L2.
+constexpr std::size_t parallel_chunk_size = 8192;
+
+} // namespace detail
+
+/*
+ * As evaluate_batch, with the points split into chunks that are evaluated on the threads of pool.
+ * Each chunk writes only its own range of out, so the results do not depend on scheduling.
+ */
+template <class T, class... Ps, class R, class... Xs>
+void parallel_evaluate_batch(
+    ThreadPool &pool, const Polynomial<T, Ps...> &p, R *out, std::size_t n, const Xs *...xs)
+{
+    constexpr std::size_t chunk = detail::parallel_chunk_size;
+    pool.parallel_for((n + chunk - 1) / chunk, [&](std::size_t task) {
+        const std::size_t start = task * chunk;
+        const std::size_t count = n - start < chunk ? n - start : chunk;
+        evaluate_batch(p, out + start, count, (xs + start)...);
+    });
+}
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_PARALLEL_HPP
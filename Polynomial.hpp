@@ -20,6 +20,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef POLYNOMIAL_POLYNOMIAL_HPP
 #define POLYNOMIAL_POLYNOMIAL_HPP
 
+#include "Evaluation.hpp"
 #include "Powers.hpp"
 
 #include <array>
@@ -46,12 +47,22 @@ constexpr std::array<T, sizeof...(Ts)> to_array(const std::tuple<Ts...> &tup) no
 
 struct PolyMaker;
 
-template <std::size_t... Is, class... Xs, class... Ps, class T>
-constexpr T eval_impl(
-    const std::array<T, sizeof...(Is)> &coeffs, std::index_sequence<Is...>, PowersList<Ps...>,
-    const Xs &...xs) noexcept
+// In-place updates of more terms than this loop over the scatter indices instead of being unrolled
+// into one statement per term, which is slow to compile for long lists.
+constexpr std::size_t max_unrolled_scatter = 256;
+
+template <class Scatter, class T, std::size_t N, class C, std::size_t... Ks>
+constexpr void scatter_add(std::array<T, N> &acc, const C &addend, std::index_sequence<Ks...>) noexcept
+{
+    ((acc[Scatter::index[Ks]] = acc[Scatter::index[Ks]] + addend[Ks]), ...);
+}
+
+// acc[index[K]] += scaled[K / M] * q[K % M] for every pair K.
+template <class Scatter, std::size_t M, class T, std::size_t N, class S, class Q, std::size_t... Ks>
+constexpr void
+scatter_products(std::array<T, N> &acc, const S &scaled, const Q &q, std::index_sequence<Ks...>) noexcept
 {
-    return ((raise(Ps{}, xs...) * coeffs[Is]) + ...);
+    ((acc[Scatter::index[Ks]] = scaled[Ks / M] * q[Ks % M] + acc[Scatter::index[Ks]]), ...);
 }
 
 } // namespace detail
@@ -59,7 +70,7 @@ constexpr T eval_impl(
 template <class T, class... Ps>
 class Polynomial
 {
-    static_assert(std::is_arithmetic_v<T>);
+    static_assert(is_numeric_v<T>, "Polynomial coefficients must be a numeric type");
     std::array<T, sizeof...(Ps)> m_coeffs;
 
     constexpr Polynomial(const std::array<T, sizeof...(Ps)> &cs) noexcept : m_coeffs(cs) {}
@@ -77,13 +88,33 @@ class Polynomial
     constexpr auto partial_impl(
         std::index_sequence<Is...>, std::integer_sequence<unsigned, As...>, PowersList<Qs...>) const noexcept
     {
-        const auto new_coeffs = std::array{(m_coeffs[Is] * As)...};
-        return make_poly(new_coeffs, PowersList<Qs...>{});
+        if constexpr (sizeof...(Is) == 0)
+        {
+            // No term depends on the variable; the derivative is the zero constant.
+            return make_poly(std::array<T, 1>{0}, total_degree_powers<PowersList<Ps...>::nvars, 0>());
+        }
+        else
+        {
+            const auto new_coeffs = std::array{(m_coeffs[Is] * As)...};
+            return make_poly(new_coeffs, PowersList<Qs...>{});
+        }
     }
 
   public:
     constexpr const auto &coeffs() const noexcept { return m_coeffs; }
     static constexpr auto num_terms = sizeof...(Ps);
+    static constexpr auto max_degrees() noexcept { return PowersList<Ps...>::max_degrees(); }
+    static constexpr unsigned total_degree() noexcept { return PowersList<Ps...>::total_degree(); }
+
+    /*
+     * Multiplications and additions done by evaluate(Strategy{}, ...), e.g. to choose a strategy
+     * with if constexpr or to static_assert a budget; see op_count in Evaluation.hpp.
+     */
+    template <class Strategy>
+    static constexpr OpCount cost(Strategy = Strategy{}) noexcept
+    {
+        return op_count(Strategy{}, PowersList<Ps...>{});
+    }
 
     constexpr Polynomial<T, Ps...> operator+(const Polynomial<T, Ps...> &other) const noexcept
     {
@@ -96,10 +127,10 @@ class Polynomial
     }
 
     template <class U>
-    constexpr std::enable_if_t<std::is_arithmetic_v<U>, Polynomial<std::common_type_t<T, U>, Ps...>>
+    constexpr std::enable_if_t<is_numeric_v<U>, Polynomial<detail::product_t<T, U>, Ps...>>
     operator*(U x) const noexcept
     {
-        std::array<std::common_type_t<T, U>, sizeof...(Ps)> new_coeffs{0};
+        std::array<detail::product_t<T, U>, sizeof...(Ps)> new_coeffs{0};
         for (unsigned i = 0; i < sizeof...(Ps); ++i)
         {
             new_coeffs[i] = m_coeffs[i] * x;
@@ -108,10 +139,10 @@ class Polynomial
     }
 
     template <class U>
-    constexpr std::enable_if_t<std::is_arithmetic_v<U>, Polynomial<std::common_type_t<T, U>, Ps...>>
+    constexpr std::enable_if_t<is_numeric_v<U>, Polynomial<detail::product_t<T, U>, Ps...>>
     operator/(U x) const noexcept
     {
-        std::array<std::common_type_t<T, U>, sizeof...(Ps)> new_coeffs{0};
+        std::array<detail::product_t<T, U>, sizeof...(Ps)> new_coeffs{0};
         for (unsigned i = 0; i < sizeof...(Ps); ++i)
         {
             new_coeffs[i] = m_coeffs[i] / x;
@@ -120,11 +151,11 @@ class Polynomial
     }
 
     template <class U>
-    constexpr std::enable_if_t<std::is_arithmetic_v<U>, Polynomial<T, Ps...>> &operator*=(U x)
+    constexpr std::enable_if_t<is_numeric_v<U>, Polynomial<T, Ps...>> &operator*=(U x)
     {
         for (unsigned i = 0; i < sizeof...(Ps); ++i)
         {
-            m_coeffs[i] *= x;
+            m_coeffs[i] = m_coeffs[i] * x;
         }
         return *this;
     }
@@ -133,18 +164,111 @@ class Polynomial
     {
         for (unsigned i = 0; i < sizeof...(Ps); ++i)
         {
-            m_coeffs[i] += other.m_coeffs[i];
+            m_coeffs[i] = m_coeffs[i] + other.m_coeffs[i];
+        }
+        return *this;
+    }
+
+    /*
+     * Add a polynomial whose terms are a subset of this one's. The position of each of its terms
+     * is found at compile time, so the update is a straight scatter with no temporary.
+     */
+    template <class U, class... Qs>
+    constexpr Polynomial<T, Ps...> &operator+=(const Polynomial<U, Qs...> &other) noexcept
+    {
+        static_assert(
+            PowersList<Qs...>::nvars == PowersList<Ps...>::nvars, "Polynomials have different nvars");
+        using Scatter = detail::SubsetScatter<PowersList<Ps...>, PowersList<Qs...>>;
+        static_assert(Scatter::valid, "Terms of the addend must be a subset of the accumulator's");
+        if constexpr (sizeof...(Qs) <= detail::max_unrolled_scatter)
+        {
+            detail::scatter_add<Scatter>(
+                m_coeffs, other.coeffs(), std::make_index_sequence<sizeof...(Qs)>());
+        }
+        else
+        {
+            for (std::size_t j = 0; j < sizeof...(Qs); ++j)
+            {
+                m_coeffs[Scatter::index[j]] = m_coeffs[Scatter::index[j]] + other.coeffs()[j];
+            }
+        }
+        return *this;
+    }
+
+    /*
+     * Add c * p * q in place, accumulating the product of each pair of terms straight into its
+     * term of this polynomial; see fma_into.
+     */
+    template <class C, class U, class... Qs, class V, class... Rs>
+    constexpr Polynomial<T, Ps...> &
+    add_product(const C &c, const Polynomial<U, Qs...> &p, const Polynomial<V, Rs...> &q) noexcept
+    {
+        static_assert(
+            PowersList<Qs...>::nvars == PowersList<Ps...>::nvars &&
+                PowersList<Rs...>::nvars == PowersList<Ps...>::nvars,
+            "Polynomials have different nvars");
+        using Scatter = detail::ProductScatter<PowersList<Ps...>, PowersList<Qs...>, PowersList<Rs...>>;
+        static_assert(Scatter::valid, "Terms of the product must be a subset of the accumulator's");
+        constexpr std::size_t N = sizeof...(Qs), M = sizeof...(Rs);
+
+        std::array<std::decay_t<decltype(c * p.coeffs()[0])>, N> scaled{};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            scaled[i] = c * p.coeffs()[i];
+        }
+        if constexpr (N * M <= detail::max_unrolled_scatter)
+        {
+            detail::scatter_products<Scatter, M>(
+                m_coeffs, scaled, q.coeffs(), std::make_index_sequence<N * M>());
+        }
+        else
+        {
+            for (std::size_t k = 0; k < N * M; ++k)
+            {
+                T &term = m_coeffs[Scatter::index[k]];
+                term = scaled[k / M] * q.coeffs()[k % M] + term;
+            }
         }
         return *this;
     }
 
     template <class... Xs>
-    constexpr T operator()(const Xs &...xs) const noexcept
+    constexpr detail::eval_result_t<T, Xs...> operator()(const Xs &...xs) const noexcept
     {
         return detail::eval_impl(
             m_coeffs, std::make_index_sequence<num_terms>(), PowersList<Ps...>{}, xs...);
     }
 
+    /*
+     * Evaluate using the given strategy (Naive, Horner<Order...>, Estrin<Order...>, PowerTable,
+     * Accumulate<Acc>, CompensatedHorner<Work>); see Evaluation.hpp.
+     */
+    template <class Strategy, class... Xs>
+    constexpr auto evaluate(Strategy, const Xs &...xs) const noexcept
+    {
+        return detail::evaluate(Strategy{}, m_coeffs, PowersList<Ps...>{}, xs...);
+    }
+
+    /*
+     * Write p(xs...) to out[0] and the partial derivatives to out[1], ..., out[nvars]. Each
+     * monomial power is computed once and shared between the value and all partials.
+     */
+    template <class Out, class... Xs>
+    constexpr void value_and_gradient(Out &&out, const Xs &...xs) const noexcept
+    {
+        detail::value_and_gradient(m_coeffs, PowersList<Ps...>{}, out, xs...);
+    }
+
+    /*
+     * As value_and_gradient, additionally writing the Hessian row-major to
+     * out[nvars + 1], ..., out[nvars + nvars * nvars].
+     */
+    template <class Out, class... Xs>
+    constexpr void value_gradient_hessian(Out &&out, const Xs &...xs) const noexcept
+    {
+        detail::value_gradient_hessian(m_coeffs, PowersList<Ps...>{}, out, xs...);
+    }
+
     template <std::size_t I>
     constexpr auto partial() const noexcept
     {
@@ -178,31 +302,27 @@ struct PolyMaker
     }
 };
 
-template <std::size_t FinalSize, class C, std::size_t... Is, std::size_t... Js>
-constexpr auto
-collect_coeffs_impl(const C &coeffs, std::index_sequence<Is...>, std::index_sequence<Js...>) noexcept
+// A loop rather than a fold over the terms, which is slow to compile for long lists.
+template <class C, std::size_t... Is, std::size_t FinalSize>
+constexpr auto collect_coeffs(
+    const C &coeffs, std::index_sequence<Is...>, std::integral_constant<std::size_t, FinalSize>) noexcept
 {
     using T = std::decay_t<decltype(coeffs[0])>;
+    constexpr std::size_t mapped_indices[] = {Is...};
     std::array<T, FinalSize> collected{0};
-    ((collected[Js] += coeffs[Is]), ...);
+    for (std::size_t i = 0; i < sizeof...(Is); ++i)
+    {
+        collected[mapped_indices[i]] = collected[mapped_indices[i]] + coeffs[i];
+    }
     return collected;
 }
 
-template <class C, std::size_t... Is, std::size_t FinalSize>
-constexpr auto collect_coeffs(
-    const C &coeffs, std::index_sequence<Is...> mapped_indices,
-    std::integral_constant<std::size_t, FinalSize>) noexcept
-{
-    return collect_coeffs_impl<FinalSize>(
-        coeffs, std::make_index_sequence<sizeof...(Is)>(), mapped_indices);
-}
-
 template <std::size_t FinalSize, class... Ts, std::size_t... Is, std::size_t... Js>
 constexpr auto collect_coeffs_impl(
     const std::tuple<Ts...> &coeffs, std::index_sequence<Is...>, std::index_sequence<Js...>) noexcept
 {
     std::array<std::common_type_t<Ts...>, FinalSize> collected{0};
-    ((collected[Js] += std::get<Is>(coeffs)), ...);
+    ((collected[Js] = collected[Js] + std::get<Is>(coeffs)), ...);
     return collected;
 }
 
@@ -268,20 +388,40 @@ constexpr auto operator+(const Polynomial<T, Ps...> &p, const Polynomial<U, Qs..
     return make_poly(coeffs, PowersList<Ps..., Qs...>{});
 }
 
+/*
+ * The position of each pairwise product among the canonical product terms is computed at compile
+ * time, so products are accumulated straight into the result without an N * M temporary.
+ */
 template <class T, class... Ps, class U, class... Qs>
 constexpr auto operator*(const Polynomial<T, Ps...> &p, const Polynomial<U, Qs...> &q) noexcept
 {
     using V = decltype(std::declval<T>() * std::declval<U>());
-    std::array<V, sizeof...(Ps) * sizeof...(Qs)> coeffs{0};
-    for (unsigned i = 0; i < sizeof...(Ps); ++i)
+    using Table = detail::ProductTable<PowersList<Ps...>, PowersList<Qs...>>;
+    std::array<V, Table::size> coeffs{0};
+    for (std::size_t i = 0; i < sizeof...(Ps); ++i)
     {
-        for (unsigned j = 0; j < sizeof...(Qs); ++j)
+        const auto *index = Table::index.data() + i * sizeof...(Qs);
+        for (std::size_t j = 0; j < sizeof...(Qs); ++j)
         {
-            coeffs[i * sizeof...(Qs) + j] = p.coeffs()[i] * q.coeffs()[j];
+            coeffs[index[j]] = coeffs[index[j]] + p.coeffs()[i] * q.coeffs()[j];
         }
     }
 
-    return make_poly(coeffs, PowersList<Ps...>{} * PowersList<Qs...>{});
+    return detail::PolyMaker::create(
+        coeffs, detail::powers_from_table<Table>(std::make_index_sequence<Table::size>()));
+}
+
+/*
+ * acc += c * p * q, for acc whose terms include every term of the product. The scatter indices are
+ * computed at compile time, so no product polynomial is formed or canonicalized; each update is a
+ * multiply-add that the compiler can contract to an FMA.
+ */
+template <class T, class... Ps, class C, class U, class... Qs, class V, class... Rs>
+constexpr Polynomial<T, Ps...> &fma_into(
+    Polynomial<T, Ps...> &acc, const C &c, const Polynomial<U, Qs...> &p,
+    const Polynomial<V, Rs...> &q) noexcept
+{
+    return acc.add_product(c, p, q);
 }
 
 template <std::size_t I, class T, class... Ps>
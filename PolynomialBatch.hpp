@@ -0,0 +1,431 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_POLYNOMIAL_BATCH_HPP
+#define POLYNOMIAL_POLYNOMIAL_BATCH_HPP
+
+#include "Batch.hpp"
+#include "Polynomial.hpp"
+#include "Simd.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Polynomials
+{
+
+namespace detail
+{
+
+template <class V, class T, std::size_t... Is, class... Ps, class... Vs>
+inline V eval_lanes_soa(
+    const T *coeffs, std::size_t stride, std::index_sequence<Is...>, PowersList<Ps...>,
+    const Vs &...xs) noexcept
+{
+    V acc(0);
+    ((acc = fma(raise(Ps{}, xs...), V::load(coeffs + Is * stride), acc)), ...);
+    return acc;
+}
+
+template <class T, class... Qs>
+auto make_poly_batch_impl(PowersList<Qs...>, std::size_t n);
+
+} // namespace detail
+
+/*
+ * An all-zero batch of n polynomials whose terms are the canonicalized form of the given PowersList.
+ */
+template <class T, class... Ps>
+auto make_poly_batch(PowersList<Ps...>, std::size_t n);
+
+/*
+ * A collection of polynomials that share one (canonical) PowersList, stored term-major: the
+ * coefficients of term j for all polynomials are contiguous, so arithmetic and evaluation
+ * vectorize across polynomials. Each term's row is padded to a whole number of SIMD vectors, so
+ * every row starts on a SIMD vector boundary; the storage as a whole starts on a cache line.
+ */
+template <class T, class... Ps>
+class PolynomialBatch
+{
+    static_assert(std::is_arithmetic_v<T>);
+    static_assert(
+        std::is_same_v<
+            PowersList<Ps...>, std::decay_t<decltype(unique_and_sorted(PowersList<Ps...>{}).second)>>,
+        "PolynomialBatch requires a sorted PowersList without duplicates; use make_poly_batch");
+
+    using V = simd::native_vec<T>;
+    static constexpr std::size_t W = V::width;
+
+    std::size_t m_size;
+    std::size_t m_stride;
+    std::vector<T, simd::AlignedAllocator<T>> m_coeffs;
+
+  public:
+    static constexpr auto num_terms = sizeof...(Ps);
+
+    explicit PolynomialBatch(std::size_t n)
+        : m_size{n}, m_stride{(n + W - 1) / W * W}, m_coeffs(m_stride * num_terms, T(0))
+    {
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+
+    // Distance between the starts of consecutive term rows in coeffs().
+    std::size_t stride() const noexcept { return m_stride; }
+
+    T *coeffs(std::size_t term) noexcept { return m_coeffs.data() + term * m_stride; }
+    const T *coeffs(std::size_t term) const noexcept { return m_coeffs.data() + term * m_stride; }
+
+    Polynomial<T, Ps...> operator[](std::size_t i) const noexcept
+    {
+        std::array<T, num_terms> cs{0};
+        for (std::size_t j = 0; j < num_terms; ++j)
+        {
+            cs[j] = coeffs(j)[i];
+        }
+        return make_poly(cs, PowersList<Ps...>{});
+    }
+
+    void set(std::size_t i, const Polynomial<T, Ps...> &p) noexcept
+    {
+        for (std::size_t j = 0; j < num_terms; ++j)
+        {
+            coeffs(j)[i] = p.coeffs()[j];
+        }
+    }
+
+    PolynomialBatch &operator+=(const PolynomialBatch &other) noexcept
+    {
+        assert(m_size == other.m_size);
+        for (std::size_t i = 0; i < m_coeffs.size(); i += W)
+        {
+            (V::load(m_coeffs.data() + i) + V::load(other.m_coeffs.data() + i)).store(m_coeffs.data() + i);
+        }
+        return *this;
+    }
+
+    PolynomialBatch operator+(const PolynomialBatch &other) const
+    {
+        PolynomialBatch result(*this);
+        result += other;
+        return result;
+    }
+
+    /*
+     * Scale every coefficient by x. As for Polynomial::operator*=, each product is formed in the
+     * common type of T and U and converted back to T.
+     */
+    template <class U>
+    std::enable_if_t<std::is_arithmetic_v<U>, PolynomialBatch &> operator*=(U x) noexcept
+    {
+        if constexpr (std::is_same_v<std::common_type_t<T, U>, T>)
+        {
+            const V scale(static_cast<T>(x));
+            for (std::size_t i = 0; i < m_coeffs.size(); i += W)
+            {
+                (V::load(m_coeffs.data() + i) * scale).store(m_coeffs.data() + i);
+            }
+        }
+        else
+        {
+            for (auto &c : m_coeffs)
+            {
+                c = static_cast<T>(c * x);
+            }
+        }
+        return *this;
+    }
+
+    /*
+     * The batch scaled by x, with coefficients promoted to the common type of T and U as
+     * Polynomial::operator* does.
+     */
+    template <class U>
+    std::enable_if_t<std::is_arithmetic_v<U>, PolynomialBatch<std::common_type_t<T, U>, Ps...>>
+    operator*(U x) const
+    {
+        using C = std::common_type_t<T, U>;
+        if constexpr (std::is_same_v<C, T>)
+        {
+            PolynomialBatch result(*this);
+            result *= x;
+            return result;
+        }
+        else
+        {
+            PolynomialBatch<C, Ps...> result(m_size);
+            for (std::size_t j = 0; j < num_terms; ++j)
+            {
+                const T *src = coeffs(j);
+                C *dst = result.coeffs(j);
+                for (std::size_t i = 0; i < m_size; ++i)
+                {
+                    dst[i] = static_cast<C>(src[i]) * static_cast<C>(x);
+                }
+            }
+            return result;
+        }
+    }
+
+    /*
+     * Partial derivative of every polynomial in the batch with respect to variable I. The
+     * coefficients keep type T.
+     */
+    template <std::size_t I>
+    auto partial() const
+    {
+        constexpr auto tup = partials_with_multipliers<I>(PowersList<Ps...>{});
+        if constexpr (std::get<0>(tup).size() == 0)
+        {
+            // No term depends on the variable; each derivative is the zero constant.
+            return make_poly_batch<T>(total_degree_powers<PowersList<Ps...>::nvars, 0>(), m_size);
+        }
+        else
+        {
+            constexpr auto indices = detail::sequence_to_array(std::get<0>(tup));
+            constexpr auto constants = detail::sequence_to_array(std::get<1>(tup));
+            constexpr auto canonical = unique_and_sorted(std::get<2>(tup));
+            constexpr auto mapped = detail::sequence_to_array(canonical.first);
+
+            auto result = make_poly_batch<T>(canonical.second, m_size);
+            for (std::size_t k = 0; k < indices.size(); ++k)
+            {
+                const V c(static_cast<T>(constants[k]));
+                const T *src = coeffs(indices[k]);
+                T *dst = result.coeffs(mapped[k]);
+                for (std::size_t i = 0; i < m_stride; i += W)
+                {
+                    fma(c, V::load(src + i), V::load(dst + i)).store(dst + i);
+                }
+            }
+            return result;
+        }
+    }
+
+    /*
+     * Evaluate every polynomial at the same point, writing the i-th value to out[i].
+     */
+    template <class R, class... Xs>
+    void evaluate(R *out, const Xs &...xs) const noexcept
+    {
+        static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Wrong number of arguments to evaluate");
+        const auto ms = monomials(PowersList<Ps...>{}, static_cast<T>(xs)...);
+        for (std::size_t i = 0; i < m_stride; i += W)
+        {
+            V acc(0);
+            for (std::size_t j = 0; j < num_terms; ++j)
+            {
+                acc = fma(V(ms[j]), V::load(coeffs(j) + i), acc);
+            }
+            detail::store_lanes<V, T>(acc, out + i, m_size - i < W ? m_size - i : W);
+        }
+    }
+
+    /*
+     * Evaluate the i-th polynomial at the i-th point, given as one array per variable.
+     */
+    template <class R, class... Xs>
+    void evaluate_each(R *out, const Xs *...xs) const noexcept
+    {
+        static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Need one input array per variable");
+        for (std::size_t i = 0; i < m_size; i += W)
+        {
+            const std::size_t count = m_size - i < W ? m_size - i : W;
+            const V acc = detail::eval_lanes_soa<V>(
+                m_coeffs.data() + i, m_stride, std::make_index_sequence<num_terms>(), PowersList<Ps...>{},
+                detail::load_lanes<V, T>(xs + i, count)...);
+            detail::store_lanes<V, T>(acc, out + i, count);
+        }
+    }
+};
+
+namespace detail
+{
+
+template <class T, class... Qs>
+auto make_poly_batch_impl(PowersList<Qs...>, std::size_t n)
+{
+    return PolynomialBatch<T, Qs...>(n);
+}
+
+} // namespace detail
+
+template <class T, class... Ps>
+auto make_poly_batch(PowersList<Ps...>, std::size_t n)
+{
+    return detail::make_poly_batch_impl<T>(unique_and_sorted(PowersList<Ps...>{}).second, n);
+}
+
+namespace detail
+{
+
+// Blocking parameters for element_gemm: rows of A (polynomials) per register tile, SIMD vectors
+// of points per register tile, terms per cache block, and points per cache block.
+constexpr std::size_t gemm_mr = 4;
+constexpr std::size_t gemm_nr = 2;
+constexpr std::size_t gemm_kc = 256;
+constexpr std::size_t gemm_nc = 512;
+
+/*
+ * Register-tiled micro-kernel: for MR consecutive polynomials starting at row e and NR vectors of
+ * points starting at q, accumulate sum_j a[j * lda + e + r] * b[j * ldb + q + c] over kc terms
+ * and add (or, if first, write) the result into out.
+ */
+template <std::size_t MR, class V, class T, class R>
+inline void gemm_micro_kernel(
+    std::size_t kc, const T *a, std::size_t lda, const T *b, std::size_t ldb, R *out, std::size_t ldo,
+    std::size_t ncols, bool first) noexcept
+{
+    constexpr std::size_t W = V::width;
+    V acc[MR][gemm_nr];
+    for (std::size_t r = 0; r < MR; ++r)
+    {
+        for (std::size_t c = 0; c < gemm_nr; ++c)
+        {
+            acc[r][c] = V(0);
+        }
+    }
+
+    for (std::size_t j = 0; j < kc; ++j)
+    {
+        V bs[gemm_nr];
+        for (std::size_t c = 0; c < gemm_nr; ++c)
+        {
+            bs[c] = V::load(b + j * ldb + c * W);
+        }
+        for (std::size_t r = 0; r < MR; ++r)
+        {
+            const V ar(a[j * lda + r]);
+            for (std::size_t c = 0; c < gemm_nr; ++c)
+            {
+                acc[r][c] = fma(ar, bs[c], acc[r][c]);
+            }
+        }
+    }
+
+    for (std::size_t r = 0; r < MR; ++r)
+    {
+        for (std::size_t c = 0; c < gemm_nr && c * W < ncols; ++c)
+        {
+            const std::size_t count = ncols - c * W < W ? ncols - c * W : W;
+            R *dst = out + r * ldo + c * W;
+            if (!first)
+            {
+                acc[r][c] = acc[r][c] + load_lanes<V, T>(dst, count);
+            }
+            store_lanes<V, T>(acc[r][c], dst, count);
+        }
+    }
+}
+
+/*
+ * out (m x n, row-major, leading dimension n) = A^T * B, where A is kdim x m with leading
+ * dimension lda and B is kdim x n with leading dimension ldb, a multiple of gemm_nr SIMD vectors
+ * whose padding columns are readable.
+ */
+template <class T, class R>
+void element_gemm(
+    std::size_t m, std::size_t n, std::size_t kdim, const T *a, std::size_t lda, const T *b,
+    std::size_t ldb, R *out) noexcept
+{
+    using V = simd::native_vec<T>;
+    constexpr std::size_t tile_cols = gemm_nr * V::width;
+
+    for (std::size_t jc = 0; jc < kdim; jc += gemm_kc)
+    {
+        const std::size_t kc = kdim - jc < gemm_kc ? kdim - jc : gemm_kc;
+        const bool first = jc == 0;
+        for (std::size_t qc = 0; qc < n; qc += gemm_nc)
+        {
+            const std::size_t qend = n - qc < gemm_nc ? n : qc + gemm_nc;
+            for (std::size_t e = 0; e < m; e += gemm_mr)
+            {
+                for (std::size_t q = qc; q < qend; q += tile_cols)
+                {
+                    const std::size_t ncols = qend - q < tile_cols ? qend - q : tile_cols;
+                    const T *ablock = a + jc * lda + e;
+                    const T *bblock = b + jc * ldb + q;
+                    R *oblock = out + e * n + q;
+                    if (m - e >= gemm_mr)
+                    {
+                        gemm_micro_kernel<gemm_mr, V>(
+                            kc, ablock, lda, bblock, ldb, oblock, n, ncols, first);
+                    }
+                    else
+                    {
+                        for (std::size_t r = 0; r < m - e; ++r)
+                        {
+                            gemm_micro_kernel<1, V>(
+                                kc, ablock + r, lda, bblock, ldb, oblock + r * n, n, ncols, first);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class PL, class T, class X, std::size_t N, std::size_t... Vs>
+void padded_monomials(
+    PL, T *table, std::size_t ldm, const std::array<std::vector<X>, N> &points,
+    std::index_sequence<Vs...>) noexcept
+{
+    monomials(PL{}, MatrixLayout::ColumnMajor, table, ldm, points[Vs].data()...);
+}
+
+} // namespace detail
+
+/*
+ * Evaluate every polynomial in the batch at each of n points (given as one array per variable),
+ * writing polynomial i at point q to out[i * n + q]. This is the product of the coefficient
+ * matrix with the monomial table of the points, computed with a cache-blocked, register-tiled
+ * kernel so each monomial is formed once regardless of the batch size.
+ */
+template <class T, class... Ps, class R, class... Xs>
+void evaluate_at_points(const PolynomialBatch<T, Ps...> &batch, R *out, std::size_t n, const Xs *...xs)
+{
+    using V = simd::native_vec<T>;
+    constexpr std::size_t tile_cols = detail::gemm_nr * V::width;
+    constexpr std::size_t nterms = PolynomialBatch<T, Ps...>::num_terms;
+    const std::size_t ldm = (n + tile_cols - 1) / tile_cols * tile_cols;
+
+    // Pad the points up to a whole number of register tiles so the kernel never reads past the table.
+    using X = std::common_type_t<Xs...>;
+    constexpr std::size_t nvars = sizeof...(Xs);
+    const std::array<const X *, nvars> inputs{xs...};
+    std::array<std::vector<X>, nvars> padded;
+    for (std::size_t v = 0; v < nvars; ++v)
+    {
+        padded[v].assign(inputs[v], inputs[v] + n);
+        padded[v].resize(ldm, X(0));
+    }
+
+    std::vector<T, simd::AlignedAllocator<T>> table(nterms * ldm);
+    detail::padded_monomials(
+        PowersList<Ps...>{}, table.data(), ldm, padded, std::make_index_sequence<nvars>());
+    detail::element_gemm(batch.size(), n, nterms, batch.coeffs(0), batch.stride(), table.data(), ldm, out);
+}
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_POLYNOMIAL_BATCH_HPP
@@ -0,0 +1,259 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_POLYNOMIAL_REF_HPP
+#define POLYNOMIAL_POLYNOMIAL_REF_HPP
+
+#include "Polynomial.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Polynomials
+{
+
+template <std::size_t I, class T, class... Ps>
+class PolynomialPartialRef;
+
+namespace detail
+{
+
+// Coefficient j of a polynomial stored at data[j * stride], indexed like a std::array.
+template <class T>
+struct StridedCoeffs
+{
+    T *data;
+    std::size_t stride;
+
+    constexpr T &operator[](std::size_t j) const noexcept { return data[j * stride]; }
+};
+
+/*
+ * Coefficient k of a partial derivative, coeffs[Is[k]] * As[k], for the indices and multipliers
+ * returned by partials_with_multipliers.
+ */
+template <class C, class Indices, class Multipliers>
+struct PartialCoeffs;
+
+template <class C, std::size_t... Is, unsigned... As>
+struct PartialCoeffs<C, std::index_sequence<Is...>, std::integer_sequence<unsigned, As...>>
+{
+    static constexpr std::size_t indices[] = {Is...};
+    static constexpr unsigned multipliers[] = {As...};
+
+    C coeffs;
+
+    constexpr coefficient_t<C> operator[](std::size_t k) const noexcept
+    {
+        return coeffs[indices[k]] * static_cast<coefficient_t<C>>(multipliers[k]);
+    }
+};
+
+} // namespace detail
+
+/*
+ * A non-owning view of the coefficients of a polynomial with terms Ps..., stored outside the
+ * library: coefficient j is coeffs[j * stride]. This lets a solver evaluate and update the
+ * polynomials of its elements in place, without copying coefficients into a Polynomial; e.g. a
+ * PolynomialBatch row is viewed with stride batch.stride(). The PowersList must be canonical (as
+ * produced by make_poly), since the coefficients cannot be reordered. With T const, the view is
+ * read-only.
+ */
+template <class T, class... Ps>
+class PolynomialRef
+{
+    static_assert(is_numeric_v<std::remove_const_t<T>>, "Polynomial coefficients must be a numeric type");
+    static_assert(
+        std::is_same_v<
+            PowersList<Ps...>, std::decay_t<decltype(unique_and_sorted(PowersList<Ps...>{}).second)>>,
+        "PolynomialRef requires a sorted PowersList without duplicates");
+
+    T *m_coeffs;
+    std::size_t m_stride;
+
+    template <std::size_t... Is, unsigned... As, class QL>
+    constexpr auto
+    partial_impl(std::index_sequence<Is...>, std::integer_sequence<unsigned, As...>, QL) const noexcept
+    {
+        if constexpr (sizeof...(Is) == 0)
+        {
+            // No term depends on the variable; the derivative is the zero constant.
+            constexpr auto zero_powers = total_degree_powers<PowersList<Ps...>::nvars, 0>();
+            return make_poly(std::array<std::remove_const_t<T>, 1>{0}, zero_powers);
+        }
+        else
+        {
+            const auto new_coeffs = std::array{(m_coeffs[Is * m_stride] * As)...};
+            return make_poly(new_coeffs, QL{});
+        }
+    }
+
+  public:
+    using value_type = std::remove_const_t<T>;
+    static constexpr auto num_terms = sizeof...(Ps);
+
+    constexpr PolynomialRef(T *coeffs, std::size_t stride = 1) noexcept : m_coeffs{coeffs}, m_stride{stride}
+    {
+    }
+
+    // A read-only or mutable view converts to a read-only one.
+    constexpr operator PolynomialRef<const value_type, Ps...>() const noexcept
+    {
+        return PolynomialRef<const value_type, Ps...>(m_coeffs, m_stride);
+    }
+
+    constexpr T *data() const noexcept { return m_coeffs; }
+    constexpr std::size_t stride() const noexcept { return m_stride; }
+    constexpr T &operator[](std::size_t j) const noexcept { return m_coeffs[j * m_stride]; }
+
+    // A Polynomial holding a copy of the coefficients.
+    constexpr Polynomial<value_type, Ps...> to_poly() const noexcept
+    {
+        std::array<value_type, num_terms> cs{0};
+        for (std::size_t j = 0; j < num_terms; ++j)
+        {
+            cs[j] = m_coeffs[j * m_stride];
+        }
+        return make_poly(cs, PowersList<Ps...>{});
+    }
+
+    template <class... Xs>
+    constexpr detail::eval_result_t<value_type, Xs...> operator()(const Xs &...xs) const noexcept
+    {
+        static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Wrong number of arguments to evaluate");
+        return detail::eval_impl(
+            detail::StridedCoeffs<T>{m_coeffs, m_stride}, std::make_index_sequence<num_terms>(),
+            PowersList<Ps...>{}, xs...);
+    }
+
+    // The partial derivative with respect to variable I, as a Polynomial owning its coefficients.
+    template <std::size_t I>
+    constexpr auto partial() const noexcept
+    {
+        constexpr auto tup = partials_with_multipliers<I>(PowersList<Ps...>{});
+        return partial_impl(std::get<0>(tup), std::get<1>(tup), std::get<2>(tup));
+    }
+
+    // The partial derivative with respect to variable I, evaluated from this view's coefficients.
+    template <std::size_t I>
+    constexpr PolynomialPartialRef<I, const value_type, Ps...> lazy_partial() const noexcept
+    {
+        return PolynomialPartialRef<I, const value_type, Ps...>(m_coeffs, m_stride);
+    }
+
+    template <class U>
+    constexpr const PolynomialRef &operator+=(const Polynomial<U, Ps...> &other) const noexcept
+    {
+        static_assert(!std::is_const_v<T>, "Cannot modify a read-only PolynomialRef");
+        for (std::size_t j = 0; j < num_terms; ++j)
+        {
+            m_coeffs[j * m_stride] = m_coeffs[j * m_stride] + other.coeffs()[j];
+        }
+        return *this;
+    }
+
+    template <class U>
+    constexpr const PolynomialRef &operator+=(const PolynomialRef<U, Ps...> &other) const noexcept
+    {
+        static_assert(!std::is_const_v<T>, "Cannot modify a read-only PolynomialRef");
+        for (std::size_t j = 0; j < num_terms; ++j)
+        {
+            m_coeffs[j * m_stride] = m_coeffs[j * m_stride] + other[j];
+        }
+        return *this;
+    }
+
+    template <class U>
+    constexpr std::enable_if_t<is_numeric_v<U>, const PolynomialRef &> operator*=(U x) const noexcept
+    {
+        static_assert(!std::is_const_v<T>, "Cannot modify a read-only PolynomialRef");
+        for (std::size_t j = 0; j < num_terms; ++j)
+        {
+            m_coeffs[j * m_stride] = m_coeffs[j * m_stride] * x;
+        }
+        return *this;
+    }
+};
+
+/*
+ * The partial derivative with respect to variable I of the polynomial viewed by a PolynomialRef,
+ * evaluated directly from the referenced coefficients; the multipliers and reduced powers are
+ * compile-time constants, so nothing is materialized.
+ */
+template <std::size_t I, class T, class... Ps>
+class PolynomialPartialRef
+{
+    T *m_coeffs;
+    std::size_t m_stride;
+
+    template <std::size_t... Is, unsigned... As, class... Qs, class... Xs>
+    constexpr auto eval(
+        std::index_sequence<Is...>, std::integer_sequence<unsigned, As...>, PowersList<Qs...>,
+        const Xs &...xs) const noexcept
+    {
+        using R = detail::eval_result_t<std::remove_const_t<T>, Xs...>;
+        if constexpr (sizeof...(Is) == 0)
+        {
+            return R(0);
+        }
+        else
+        {
+            using Coeffs = detail::PartialCoeffs<
+                detail::StridedCoeffs<T>, std::index_sequence<Is...>,
+                std::integer_sequence<unsigned, As...>>;
+            return static_cast<R>(detail::eval_impl(
+                Coeffs{{m_coeffs, m_stride}}, std::index_sequence_for<Qs...>(), PowersList<Qs...>{},
+                xs...));
+        }
+    }
+
+  public:
+    constexpr PolynomialPartialRef(T *coeffs, std::size_t stride) noexcept
+        : m_coeffs{coeffs}, m_stride{stride}
+    {
+    }
+
+    template <class... Xs>
+    constexpr auto operator()(const Xs &...xs) const noexcept
+    {
+        static_assert(sizeof...(Xs) == PowersList<Ps...>::nvars, "Wrong number of arguments to evaluate");
+        constexpr auto tup = partials_with_multipliers<I>(PowersList<Ps...>{});
+        return eval(std::get<0>(tup), std::get<1>(tup), std::get<2>(tup), xs...);
+    }
+};
+
+// A view of coeffs[0], coeffs[stride], ... as the coefficients of the canonical PowersList<Ps...>.
+template <class T, class... Ps>
+constexpr PolynomialRef<T, Ps...>
+make_poly_ref(T *coeffs, PowersList<Ps...>, std::size_t stride = 1) noexcept
+{
+    return PolynomialRef<T, Ps...>(coeffs, stride);
+}
+
+template <std::size_t I, class T, class... Ps>
+constexpr auto partial(const PolynomialRef<T, Ps...> &p) noexcept
+{
+    return p.template partial<I>();
+}
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_POLYNOMIAL_REF_HPP
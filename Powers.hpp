@@ -105,19 +105,11 @@ struct is_powers<Powers<Ps...>>
     constexpr static bool value = true;
 };
 
+// Folds rather than recursion, so that lists with thousands of terms do not exceed the
+// template instantiation depth.
 template <class... Ps>
-struct all_are_powers;
-
-template <>
-struct all_are_powers<>
+struct all_are_powers : public std::bool_constant<(is_powers<Ps>::value && ...)>
 {
-    static constexpr bool value = true;
-};
-
-template <class P, class... Ps>
-struct all_are_powers<P, Ps...>
-{
-    static constexpr bool value = is_powers<P>::value && all_are_powers<Ps...>::value;
 };
 
 template <class... Ps>
@@ -128,14 +120,8 @@ struct all_same_size<> : public std::true_type
 {
 };
 
-template <class P>
-struct all_same_size<P> : public std::true_type
-{
-};
-
-template <class P, class Q, class... Ps>
-struct all_same_size<P, Q, Ps...>
-    : public std::bool_constant<P::nvars == Q::nvars && all_same_size<Ps...>::value>
+template <class P, class... Ps>
+struct all_same_size<P, Ps...> : public std::bool_constant<((P::nvars == Ps::nvars) && ...)>
 {
 };
 
@@ -164,6 +150,42 @@ struct PowersList
     constexpr static auto size = sizeof...(Ps);
     static constexpr std::size_t nvars = std::tuple_element_t<0, std::tuple<Ps...>>::nvars;
 
+    // The largest exponent of each variable among the terms.
+    static constexpr auto max_degrees() noexcept
+    {
+        std::array<unsigned, nvars> maxes{};
+        for (const auto &term : {Ps::terms...})
+        {
+            for (std::size_t v = 0; v < nvars; ++v)
+            {
+                maxes[v] = term[v] > maxes[v] ? term[v] : maxes[v];
+            }
+        }
+        return maxes;
+    }
+
+    // The largest sum of exponents of any term.
+    static constexpr unsigned total_degree() noexcept
+    {
+        unsigned degree = 0;
+        for (unsigned sum : {Ps::sum...})
+        {
+            degree = sum > degree ? sum : degree;
+        }
+        return degree;
+    }
+
+    /*
+     * Multiplications and additions done to evaluate a polynomial with these terms using Strategy
+     * (Naive, Horner<Order...>, Estrin<Order...>, PowerTable or Accumulate); see op_count in
+     * Evaluation.hpp.
+     */
+    template <class Strategy>
+    static constexpr auto cost(Strategy = Strategy{}) noexcept
+    {
+        return op_count(Strategy{}, PowersList{});
+    }
+
     template <class... Qs>
     constexpr auto operator+(PowersList<Qs...>) const noexcept
     {
@@ -220,7 +242,7 @@ constexpr auto raise(Powers<Ps...>, const std::tuple<Ts...> &xs) noexcept
 }
 
 template <class... Ts, unsigned... Ps>
-constexpr auto raise(Powers<Ps...>, Ts... xs) noexcept
+constexpr auto raise(Powers<Ps...>, const Ts &...xs) noexcept
 {
     return (raise<Ps>(xs) * ...);
 }
@@ -282,130 +304,269 @@ constexpr bool array_less_than(const std::array<unsigned, N> &a, const std::arra
     return false;
 }
 
-template <std::size_t n, std::size_t sz>
-constexpr auto sort_array(const std::array<std::array<unsigned, n>, sz> &a) noexcept
+/*
+ * Stable bottom-up merge sort in O(n log n) constexpr steps. The two halves of each pass alternate
+ * between arr and a buffer through raw pointers; calls to std::array::operator[] are comparatively
+ * expensive in constant evaluation.
+ */
+template <class T, std::size_t Sz, class Less>
+constexpr std::array<T, Sz> merge_sort(std::array<T, Sz> arr, Less less) noexcept
 {
-    std::array<std::array<unsigned, n>, sz> cp = a;
-
-    constexpr auto sorting_pass = [](auto &arr) {
-        if (arr.size() < 2)
-        {
-            return false;
-        }
-
-        bool modified = false;
-        for (auto it = arr.begin(); it != arr.end() - 1; ++it)
+    std::array<T, Sz> buffer{};
+    T *src = arr.data();
+    T *dst = buffer.data();
+    for (std::size_t width = 1; width < Sz; width *= 2)
+    {
+        for (std::size_t lo = 0; lo < Sz; lo += 2 * width)
         {
-            if (array_less_than(*(it + 1), *it))
+            const std::size_t mid = lo + width < Sz ? lo + width : Sz;
+            const std::size_t hi = lo + 2 * width < Sz ? lo + 2 * width : Sz;
+            std::size_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+            {
+                dst[k++] = less(src[j], src[i]) ? src[j++] : src[i++];
+            }
+            while (i < mid)
             {
-                auto tmp = *it;
-                *it = *(it + 1);
-                *(it + 1) = tmp;
-                modified = true;
+                dst[k++] = src[i++];
+            }
+            while (j < hi)
+            {
+                dst[k++] = src[j++];
             }
         }
-        return modified;
-    };
-
-    while (sorting_pass(cp))
-        ;
-    return cp;
+        T *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    return src == arr.data() ? arr : buffer;
 }
 
-template <class P, class A>
-constexpr std::size_t map_power(const A &arr) noexcept
+// Position of the first element of the sorted array arr that is not less than val.
+template <class T, std::size_t Sz, class Less>
+constexpr std::size_t lower_bound_index(const std::array<T, Sz> &arr, const T &val, Less less) noexcept
 {
-    constexpr auto to_compare = to_array(P{});
-    for (std::size_t i = 0; i < arr.size(); ++i)
+    std::size_t lo = 0, hi = Sz;
+    while (lo < hi)
     {
-        if (compare_arrays(to_compare, arr[i]))
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (less(arr[mid], val))
         {
-            return i;
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
         }
     }
+    return lo;
 }
 
-template <std::size_t N, std::size_t Sz>
-constexpr std::size_t num_unique_powers(const std::array<std::array<unsigned, N>, Sz> &arr) noexcept
+/*
+ * The PowersList whose terms are the rows Is of Table::value, an array of exponent arrays. Rows
+ * are formed with an alias template rather than a function per row; for long lists each such
+ * function's symbol would spell out Table, and GCC is very slow to process thousands of them.
+ */
+template <class Table, class Vars>
+struct TableRows;
+
+template <class Table, std::size_t... Vs>
+struct TableRows<Table, std::index_sequence<Vs...>>
+{
+    template <std::size_t I>
+    using row = Powers<Table::value[I][Vs]...>;
+};
+
+template <class Table, std::size_t... Is>
+constexpr auto powers_from_table(std::index_sequence<Is...>) noexcept
+{
+    constexpr std::size_t nvars = std::tuple_size_v<std::decay_t<decltype(Table::value[0])>>;
+    using Rows = TableRows<Table, std::make_index_sequence<nvars>>;
+    return PowersList<typename Rows::template row<Is>...>{};
+}
+
+/*
+ * Exponent arrays encoded as mixed-radix integers. Provided every exponent of variable v is less
+ * than radix[v], keys compare in the same order as the arrays themselves, so canonicalization can
+ * sort and compare single integers.
+ */
+template <std::size_t N>
+struct ExponentKeys
 {
-    // Input array is already sorted.
-    std::size_t count = 0;
-    std::size_t index = 0;
-    while (index < Sz)
+    std::array<unsigned long long, N> radix;
+
+    // Number of distinct keys, or 0 if that does not fit in an unsigned long long.
+    constexpr unsigned long long key_space() const noexcept
     {
-        count += 1;
-        const auto val = arr[index];
-        do
+        unsigned long long size = 1;
+        for (auto r : radix)
         {
-            index += 1;
-        } while (index < Sz && compare_arrays(arr[index], val));
+            if (size > ~0ULL / r)
+            {
+                return 0;
+            }
+            size *= r;
+        }
+        return size;
     }
-    return count;
-}
 
-template <std::size_t FinalSize, std::size_t N, std::size_t Sz>
-constexpr std::array<std::array<unsigned, N>, FinalSize>
-get_unique_array(const std::array<std::array<unsigned, N>, Sz> &arr) noexcept
-{
-    std::array<std::array<unsigned, N>, FinalSize> result{0};
-    std::size_t index = 0;
-    std::size_t count = 0;
-    while (index < Sz)
+    constexpr unsigned long long encode(const std::array<unsigned, N> &exponents) const noexcept
     {
-        result[count++] = arr[index];
-        const auto val = arr[index];
-        do
+        unsigned long long key = 0;
+        for (std::size_t v = 0; v < N; ++v)
         {
-            index += 1;
-        } while (index < Sz && compare_arrays(arr[index], val));
+            key = key * radix[v] + exponents[v];
+        }
+        return key;
     }
-    return result;
-}
 
+    constexpr std::array<unsigned, N> decode(unsigned long long key) const noexcept
+    {
+        std::array<unsigned, N> exponents{};
+        for (std::size_t v = N; v > 0; --v)
+        {
+            exponents[v - 1] = static_cast<unsigned>(key % radix[v - 1]);
+            key /= radix[v - 1];
+        }
+        return exponents;
+    }
+};
+
+/*
+ * Canonical form of a list of terms: the distinct exponent arrays in lexicographic order, and for
+ * each input term its position among them. Sorting is O(n log n) and each term is located by
+ * binary search, all within a single instantiation. Terms are handled as integer keys when those
+ * fit in 64 bits, which is far cheaper to evaluate at compile time than comparing arrays.
+ */
 template <class... Ps>
 struct UniqueAndSorted
 {
-    static constexpr auto sorted_array = sort_array(expand_powers(Ps{}...));
-    static constexpr auto value = get_unique_array<num_unique_powers(sorted_array)>(sorted_array);
-    static constexpr auto size = value.size();
-};
+    static constexpr auto terms = expand_powers(Ps{}...);
+    static constexpr std::size_t nvars = std::tuple_size_v<std::decay_t<decltype(terms[0])>>;
+    using Term = std::array<unsigned, nvars>;
 
-template <std::size_t i, class... Ps>
-constexpr std::size_t get_power_index(PowersList<Ps...>) noexcept
-{
-    static_assert(i < UniqueAndSorted<Ps...>::size);
-    constexpr auto expanded = expand_powers(Ps{}...);
-    for (std::size_t j = 0; j < sizeof...(Ps); ++j)
+    static constexpr ExponentKeys<nvars> keys = []() {
+        ExponentKeys<nvars> result{};
+        for (std::size_t v = 0; v < nvars; ++v)
+        {
+            unsigned max = 0;
+            for (const auto &term : terms)
+            {
+                max = term[v] > max ? term[v] : max;
+            }
+            result.radix[v] = max + 1ULL;
+        }
+        return result;
+    }();
+
+    static constexpr bool use_keys = keys.key_space() != 0;
+    using Key = std::conditional_t<use_keys, unsigned long long, Term>;
+
+    static constexpr Key to_key(const Term &term) noexcept
     {
-        if (compare_arrays(UniqueAndSorted<Ps...>::value[i], expanded[j]))
+        if constexpr (use_keys)
         {
-            return j;
+            return keys.encode(term);
+        }
+        else
+        {
+            return term;
         }
     }
-}
 
-template <std::size_t... Is, class... Ps>
-constexpr auto get_final_powers_impl(std::index_sequence<Is...>, PowersList<Ps...>) noexcept
-{
-    return PowersList<std::decay_t<decltype(PowersList<Ps...>::template term<get_power_index<Is>(PowersList<Ps...>{})>())>...>{};
-}
+    static constexpr Term from_key(const Key &key) noexcept
+    {
+        if constexpr (use_keys)
+        {
+            return keys.decode(key);
+        }
+        else
+        {
+            return key;
+        }
+    }
 
-template <class... Ps>
-constexpr auto get_final_powers(PowersList<Ps...>) noexcept
-{
-    constexpr std::size_t num_unique = UniqueAndSorted<Ps...>::value.size();
-    constexpr auto helper_seq = std::make_index_sequence<num_unique>();
-    return get_final_powers_impl(helper_seq, PowersList<Ps...>{});
-}
+    static constexpr bool less(const Key &a, const Key &b) noexcept
+    {
+        if constexpr (use_keys)
+        {
+            return a < b;
+        }
+        else
+        {
+            return array_less_than(a, b);
+        }
+    }
+
+    static constexpr auto sorted = []() {
+        std::array<Key, sizeof...(Ps)> result{};
+        for (std::size_t i = 0; i < sizeof...(Ps); ++i)
+        {
+            result[i] = to_key(terms[i]);
+        }
+        return merge_sort(result, less);
+    }();
+
+    static constexpr std::size_t size = []() {
+        std::size_t count = 1;
+        for (std::size_t k = 1; k < sorted.size(); ++k)
+        {
+            count += less(sorted[k - 1], sorted[k]);
+        }
+        return count;
+    }();
+
+    static constexpr auto unique_keys = []() {
+        std::array<Key, size> result{sorted[0]};
+        std::size_t count = 1;
+        for (std::size_t k = 1; k < sorted.size(); ++k)
+        {
+            if (less(sorted[k - 1], sorted[k]))
+            {
+                result[count++] = sorted[k];
+            }
+        }
+        return result;
+    }();
+
+    static constexpr auto value = []() {
+        std::array<Term, size> result{};
+        for (std::size_t k = 0; k < size; ++k)
+        {
+            result[k] = from_key(unique_keys[k]);
+        }
+        return result;
+    }();
+
+    static constexpr auto mapping = []() {
+        std::array<std::size_t, sizeof...(Ps)> result{};
+        for (std::size_t i = 0; i < sizeof...(Ps); ++i)
+        {
+            result[i] = lower_bound_index(unique_keys, to_key(terms[i]), less);
+        }
+        return result;
+    }();
+
+    template <std::size_t... Is>
+    static constexpr auto indices(std::index_sequence<Is...>) noexcept
+    {
+        return std::index_sequence<mapping[Is]...>{};
+    }
+};
 
 } // namespace detail
 
+/*
+ * Returns a pair of an index_sequence, giving for each term of the list its position in the
+ * canonical list, and the canonical list itself (distinct terms in lexicographic order).
+ */
 template <class... Ps>
 constexpr auto unique_and_sorted(PowersList<Ps...>)
 {
-    constexpr auto final_indices =
-        std::index_sequence<detail::map_power<Ps>(detail::UniqueAndSorted<Ps...>::value)...>{};
-    constexpr auto final_powers = detail::get_final_powers(PowersList<Ps...>{});
+    using Canonical = detail::UniqueAndSorted<Ps...>;
+    constexpr auto final_indices = Canonical::indices(std::index_sequence_for<Ps...>());
+    constexpr auto final_powers =
+        detail::powers_from_table<Canonical>(std::make_index_sequence<Canonical::size>());
     return std::make_pair(final_indices, final_powers);
 }
 
@@ -489,13 +650,380 @@ constexpr auto do_partials(PowersList<Ps...>) noexcept
 template <std::size_t I, class... Ps>
 constexpr auto partials_with_multipliers(PowersList<Ps...>)
 {
-    static_assert(I < sizeof...(Ps), "Partial derivative index out of bounds");
+    static_assert(I < PowersList<Ps...>::nvars, "Partial derivative index out of bounds");
     constexpr auto indices = typename detail::FilterZeroPowers<I, Ps...>::seq_type{};
     constexpr auto filtered = typename detail::FilterZeroPowers<I, Ps...>::plist_type{};
     constexpr auto constants_and_powers = detail::do_partials<I>(filtered);
     return std::tuple(indices, constants_and_powers.first, constants_and_powers.second);
 }
 
+namespace detail
+{
+
+constexpr std::size_t binomial(std::size_t n, std::size_t k) noexcept
+{
+    std::size_t result = 1;
+    for (std::size_t i = 1; i <= k; ++i)
+    {
+        result = result * (n - k + i) / i;
+    }
+    return result;
+}
+
+template <std::size_t NVars, unsigned Degree>
+struct TotalDegreeTable
+{
+    static constexpr std::size_t size = binomial(NVars + Degree, Degree);
+
+    static constexpr auto compute() noexcept
+    {
+        std::array<std::array<unsigned, NVars>, size> table{};
+        std::array<unsigned, NVars> current{};
+        std::size_t count = 0;
+        while (true)
+        {
+            unsigned sum = 0;
+            for (auto p : current)
+            {
+                sum += p;
+            }
+            if (sum <= Degree)
+            {
+                table[count++] = current;
+            }
+
+            // Advance to the next exponent tuple in lexicographic order.
+            std::size_t v = NVars;
+            while (v > 0 && current[v - 1] == Degree)
+            {
+                current[v - 1] = 0;
+                v -= 1;
+            }
+            if (v == 0)
+            {
+                break;
+            }
+            current[v - 1] += 1;
+        }
+        return table;
+    }
+
+    static constexpr auto value = compute();
+};
+
+/*
+ * The canonical terms of the product of two PowersLists, and for each pair of terms (i, j) the
+ * position index[i * M + j] of their product among them. When the key space of the product is
+ * small (e.g. total degree bases) the distinct products are found by marking a dense table of
+ * keys, which is linear in N * M; otherwise the keys are merge sorted. If the keys do not fit in
+ * 64 bits, the exponent arrays themselves are sorted and compared, as in UniqueAndSorted.
+ */
+template <class PL, class QL>
+struct ProductTable;
+
+template <class... Ps, class... Qs>
+struct ProductTable<PowersList<Ps...>, PowersList<Qs...>>
+{
+    static constexpr std::size_t N = sizeof...(Ps);
+    static constexpr std::size_t M = sizeof...(Qs);
+    static constexpr std::size_t nvars = PowersList<Ps...>::nvars;
+    static_assert(
+        nvars == PowersList<Qs...>::nvars, "Product of polynomials in different numbers of variables");
+
+    static constexpr auto ps = expand_powers(Ps{}...);
+    static constexpr auto qs = expand_powers(Qs{}...);
+
+    static constexpr ExponentKeys<nvars> keys = []() {
+        ExponentKeys<nvars> result{};
+        for (std::size_t v = 0; v < nvars; ++v)
+        {
+            unsigned pmax = 0, qmax = 0;
+            for (const auto &p : ps)
+            {
+                pmax = p[v] > pmax ? p[v] : pmax;
+            }
+            for (const auto &q : qs)
+            {
+                qmax = q[v] > qmax ? q[v] : qmax;
+            }
+            result.radix[v] = pmax + qmax + 1ULL;
+        }
+        return result;
+    }();
+
+    static constexpr unsigned long long key_space = keys.key_space();
+    static constexpr bool use_keys = key_space != 0;
+    static constexpr bool dense = use_keys && key_space <= 4 * N * M;
+    using Term = std::array<unsigned, nvars>;
+    using Key = std::conditional_t<use_keys, unsigned long long, Term>;
+
+    // No digit of a product can carry, so the key of a product is the sum of the factors' keys.
+    template <std::size_t Sz>
+    static constexpr auto encode_all(const std::array<std::array<unsigned, nvars>, Sz> &terms) noexcept
+    {
+        std::array<unsigned long long, Sz> result{};
+        for (std::size_t i = 0; i < Sz; ++i)
+        {
+            result[i] = keys.encode(terms[i]);
+        }
+        return result;
+    }
+
+    static constexpr auto pkeys = encode_all(ps);
+    static constexpr auto qkeys = encode_all(qs);
+
+    static constexpr Key pair_key(std::size_t i, std::size_t j) noexcept
+    {
+        if constexpr (use_keys)
+        {
+            return pkeys[i] + qkeys[j];
+        }
+        else
+        {
+            Term product{};
+            for (std::size_t v = 0; v < nvars; ++v)
+            {
+                product[v] = ps[i][v] + qs[j][v];
+            }
+            return product;
+        }
+    }
+
+    // Dense strategy: rank[key] is one more than the position of key among the product terms, or
+    // zero if no pair of terms has that product.
+    static constexpr auto ranks = []() {
+        std::array<unsigned, dense ? key_space : 1> rank{};
+        if constexpr (dense)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                for (std::size_t j = 0; j < M; ++j)
+                {
+                    rank[pair_key(i, j)] = 1;
+                }
+            }
+            unsigned count = 0;
+            for (auto &r : rank)
+            {
+                r = r == 0 ? 0 : ++count;
+            }
+        }
+        return rank;
+    }();
+
+    static constexpr auto key_less = [](const Key &a, const Key &b) {
+        if constexpr (use_keys)
+        {
+            return a < b;
+        }
+        else
+        {
+            return array_less_than(a, b);
+        }
+    };
+
+    // Sorting strategy: the keys of all pairs in order.
+    static constexpr auto sorted_keys = []() {
+        std::array<Key, dense ? 1 : N * M> sorted{};
+        if constexpr (!dense)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                for (std::size_t j = 0; j < M; ++j)
+                {
+                    sorted[i * M + j] = pair_key(i, j);
+                }
+            }
+            sorted = merge_sort(sorted, key_less);
+        }
+        return sorted;
+    }();
+
+    static constexpr std::size_t size = []() {
+        std::size_t count = 0;
+        if constexpr (dense)
+        {
+            for (auto r : ranks)
+            {
+                count = r > count ? r : count;
+            }
+        }
+        else
+        {
+            for (std::size_t k = 0; k < sorted_keys.size(); ++k)
+            {
+                count += k == 0 || key_less(sorted_keys[k - 1], sorted_keys[k]);
+            }
+        }
+        return count;
+    }();
+
+    static constexpr auto unique_keys = []() {
+        std::array<Key, size> result{};
+        std::size_t count = 0;
+        if constexpr (dense)
+        {
+            for (std::size_t key = 0; key < ranks.size(); ++key)
+            {
+                if (ranks[key] != 0)
+                {
+                    result[count++] = key;
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t k = 0; k < sorted_keys.size(); ++k)
+            {
+                if (k == 0 || key_less(sorted_keys[k - 1], sorted_keys[k]))
+                {
+                    result[count++] = sorted_keys[k];
+                }
+            }
+        }
+        return result;
+    }();
+
+    static constexpr auto value = []() {
+        std::array<Term, size> result{};
+        for (std::size_t k = 0; k < size; ++k)
+        {
+            if constexpr (use_keys)
+            {
+                result[k] = keys.decode(unique_keys[k]);
+            }
+            else
+            {
+                result[k] = unique_keys[k];
+            }
+        }
+        return result;
+    }();
+
+    using index_type = std::conditional_t<(size <= 0xffff), unsigned short, unsigned>;
+
+    static constexpr auto index = []() {
+        std::array<index_type, N * M> result{};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            for (std::size_t j = 0; j < M; ++j)
+            {
+                const auto key = pair_key(i, j);
+                if constexpr (dense)
+                {
+                    result[i * M + j] = static_cast<index_type>(ranks[key] - 1);
+                }
+                else
+                {
+                    result[i * M + j] =
+                        static_cast<index_type>(lower_bound_index(unique_keys, key, key_less));
+                }
+            }
+        }
+        return result;
+    }();
+};
+
+/*
+ * Scatter indices for updating, in place, a polynomial whose canonical terms are PowersList<As...>:
+ * the position among them of each term of an addend (subset_index), or of the product of each
+ * pair (i, j) of terms of two factors (product_index, at i * M + j). A term that is not among
+ * As... is given position size, which callers reject with a static_assert.
+ */
+template <class AL>
+struct TermPositions;
+
+template <class... As>
+struct TermPositions<PowersList<As...>>
+{
+    static constexpr std::size_t size = sizeof...(As);
+    static constexpr std::size_t nvars = PowersList<As...>::nvars;
+    using Term = std::array<unsigned, nvars>;
+
+    static constexpr auto terms = expand_powers(As{}...);
+
+    static constexpr std::size_t find(const Term &term) noexcept
+    {
+        constexpr auto less = [](const Term &a, const Term &b) { return array_less_than(a, b); };
+        const std::size_t i = lower_bound_index(terms, term, less);
+        return i < size && compare_arrays(terms[i], term) ? i : size;
+    }
+
+    template <class... Qs>
+    static constexpr std::array<std::size_t, sizeof...(Qs)> subset_index(PowersList<Qs...>) noexcept
+    {
+        constexpr auto qs = expand_powers(Qs{}...);
+        std::array<std::size_t, sizeof...(Qs)> index{};
+        for (std::size_t j = 0; j < qs.size(); ++j)
+        {
+            index[j] = find(qs[j]);
+        }
+        return index;
+    }
+
+    template <class... Ps, class... Qs>
+    static constexpr std::array<std::size_t, sizeof...(Ps) * sizeof...(Qs)>
+    product_index(PowersList<Ps...>, PowersList<Qs...>) noexcept
+    {
+        constexpr auto ps = expand_powers(Ps{}...);
+        constexpr auto qs = expand_powers(Qs{}...);
+        std::array<std::size_t, sizeof...(Ps) * sizeof...(Qs)> index{};
+        for (std::size_t i = 0; i < ps.size(); ++i)
+        {
+            for (std::size_t j = 0; j < qs.size(); ++j)
+            {
+                Term product{};
+                for (std::size_t v = 0; v < nvars; ++v)
+                {
+                    product[v] = ps[i][v] + qs[j][v];
+                }
+                index[i * qs.size() + j] = find(product);
+            }
+        }
+        return index;
+    }
+
+    template <std::size_t N>
+    static constexpr bool all_found(const std::array<std::size_t, N> &index) noexcept
+    {
+        for (auto i : index)
+        {
+            if (i == size)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+template <class AL, class QL>
+struct SubsetScatter
+{
+    static constexpr auto index = TermPositions<AL>::subset_index(QL{});
+    static constexpr bool valid = TermPositions<AL>::all_found(index);
+};
+
+template <class AL, class PL, class QL>
+struct ProductScatter
+{
+    static constexpr auto index = TermPositions<AL>::product_index(PL{}, QL{});
+    static constexpr bool valid = TermPositions<AL>::all_found(index);
+};
+
+} // namespace detail
+
+/*
+ * The PowersList of all monomials in NVars variables with total degree at most Degree, in the
+ * canonical order produced by unique_and_sorted.
+ */
+template <std::size_t NVars, unsigned Degree>
+constexpr auto total_degree_powers() noexcept
+{
+    using Table = detail::TotalDegreeTable<NVars, Degree>;
+    return detail::powers_from_table<Table>(std::make_index_sequence<Table::size>());
+}
+
 } // namespace Polynomials
 
 #endif // POLYNOMIAL_POWERS_HPP
@@ -0,0 +1,395 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_SIMD_HPP
+#define POLYNOMIAL_SIMD_HPP
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#if defined(__AVX__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace Polynomials
+{
+
+namespace simd
+{
+
+/*
+ * Number of lanes of T that fit in one native vector register. Falls back to 1 (plain scalar code)
+ * when the target has no AVX or AVX-512 support.
+ */
+template <class T>
+struct native_width : public std::integral_constant<std::size_t, 1>
+{
+};
+
+#if defined(__AVX512F__)
+template <>
+struct native_width<double> : public std::integral_constant<std::size_t, 8>
+{
+};
+
+template <>
+struct native_width<float> : public std::integral_constant<std::size_t, 16>
+{
+};
+#elif defined(__AVX__)
+template <>
+struct native_width<double> : public std::integral_constant<std::size_t, 4>
+{
+};
+
+template <>
+struct native_width<float> : public std::integral_constant<std::size_t, 8>
+{
+};
+#endif
+
+template <class T>
+constexpr std::size_t native_width_v = native_width<T>::value;
+
+/*
+ * A pack of W lanes of T supporting the arithmetic needed to evaluate a polynomial. The generic
+ * version is a plain array that the compiler is free to auto-vectorize; widths matching a native
+ * register are specialized below to use intrinsics directly.
+ */
+template <class T, std::size_t W>
+struct Vec
+{
+    std::array<T, W> lanes;
+
+    Vec() noexcept = default;
+
+    constexpr Vec(T x) noexcept : lanes{}
+    {
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            lanes[i] = x;
+        }
+    }
+
+    static constexpr std::size_t width = W;
+
+    // Whether fma rounds once; the generic version multiplies and adds separately.
+    static constexpr bool fused_fma = false;
+
+    static Vec load(const T *src) noexcept
+    {
+        Vec v{};
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            v.lanes[i] = src[i];
+        }
+        return v;
+    }
+
+    void store(T *dst) const noexcept
+    {
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            dst[i] = lanes[i];
+        }
+    }
+
+    constexpr T operator[](std::size_t i) const noexcept { return lanes[i]; }
+
+    friend constexpr Vec operator+(const Vec &a, const Vec &b) noexcept
+    {
+        Vec result{};
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            result.lanes[i] = a.lanes[i] + b.lanes[i];
+        }
+        return result;
+    }
+
+    friend constexpr Vec operator*(const Vec &a, const Vec &b) noexcept
+    {
+        Vec result{};
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            result.lanes[i] = a.lanes[i] * b.lanes[i];
+        }
+        return result;
+    }
+
+    friend constexpr Vec operator-(const Vec &a, const Vec &b) noexcept
+    {
+        Vec result{};
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            result.lanes[i] = a.lanes[i] - b.lanes[i];
+        }
+        return result;
+    }
+
+    friend constexpr Vec operator-(const Vec &a) noexcept
+    {
+        Vec result{};
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            result.lanes[i] = -a.lanes[i];
+        }
+        return result;
+    }
+
+    friend constexpr Vec fma(const Vec &a, const Vec &b, const Vec &c) noexcept
+    {
+        Vec result{};
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            result.lanes[i] = a.lanes[i] * b.lanes[i] + c.lanes[i];
+        }
+        return result;
+    }
+};
+
+#if defined(__AVX__) || defined(__AVX512F__)
+
+/*
+ * Returns x unchanged, but hides the computation producing it from the optimizer, so that e.g. a
+ * product is rounded on its own rather than fused with a later addition.
+ */
+template <class R>
+inline R opaque(R x) noexcept
+{
+#if defined(__GNUC__)
+    asm("" : "+v"(x));
+#endif
+    return x;
+}
+
+#endif
+
+#if defined(__AVX__)
+
+template <>
+struct Vec<double, 4>
+{
+    __m256d v;
+
+    Vec() noexcept = default;
+    Vec(double x) noexcept : v{_mm256_set1_pd(x)} {}
+    Vec(__m256d x) noexcept : v{x} {}
+
+    static constexpr std::size_t width = 4;
+#if defined(__FMA__)
+    static constexpr bool fused_fma = true;
+#else
+    static constexpr bool fused_fma = false;
+#endif
+
+    static Vec load(const double *src) noexcept { return _mm256_loadu_pd(src); }
+    void store(double *dst) const noexcept { _mm256_storeu_pd(dst, v); }
+
+    double operator[](std::size_t i) const noexcept
+    {
+        alignas(32) double tmp[4];
+        _mm256_store_pd(tmp, v);
+        return tmp[i];
+    }
+
+    friend Vec operator+(const Vec &a, const Vec &b) noexcept { return _mm256_add_pd(a.v, b.v); }
+    friend Vec operator*(const Vec &a, const Vec &b) noexcept { return _mm256_mul_pd(a.v, b.v); }
+    friend Vec operator-(const Vec &a, const Vec &b) noexcept { return _mm256_sub_pd(a.v, b.v); }
+    friend Vec operator-(const Vec &a) noexcept { return _mm256_sub_pd(_mm256_setzero_pd(), a.v); }
+    friend Vec keep_rounded(Vec a) noexcept { return opaque(a.v); }
+
+    friend Vec fma(const Vec &a, const Vec &b, const Vec &c) noexcept
+    {
+#if defined(__FMA__)
+        return _mm256_fmadd_pd(a.v, b.v, c.v);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v);
+#endif
+    }
+};
+
+template <>
+struct Vec<float, 8>
+{
+    __m256 v;
+
+    Vec() noexcept = default;
+    Vec(float x) noexcept : v{_mm256_set1_ps(x)} {}
+    Vec(__m256 x) noexcept : v{x} {}
+
+    static constexpr std::size_t width = 8;
+#if defined(__FMA__)
+    static constexpr bool fused_fma = true;
+#else
+    static constexpr bool fused_fma = false;
+#endif
+
+    static Vec load(const float *src) noexcept { return _mm256_loadu_ps(src); }
+    void store(float *dst) const noexcept { _mm256_storeu_ps(dst, v); }
+
+    float operator[](std::size_t i) const noexcept
+    {
+        alignas(32) float tmp[8];
+        _mm256_store_ps(tmp, v);
+        return tmp[i];
+    }
+
+    friend Vec operator+(const Vec &a, const Vec &b) noexcept { return _mm256_add_ps(a.v, b.v); }
+    friend Vec operator*(const Vec &a, const Vec &b) noexcept { return _mm256_mul_ps(a.v, b.v); }
+    friend Vec operator-(const Vec &a, const Vec &b) noexcept { return _mm256_sub_ps(a.v, b.v); }
+    friend Vec operator-(const Vec &a) noexcept { return _mm256_sub_ps(_mm256_setzero_ps(), a.v); }
+    friend Vec keep_rounded(Vec a) noexcept { return opaque(a.v); }
+
+    friend Vec fma(const Vec &a, const Vec &b, const Vec &c) noexcept
+    {
+#if defined(__FMA__)
+        return _mm256_fmadd_ps(a.v, b.v, c.v);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v);
+#endif
+    }
+};
+
+#endif // __AVX__
+
+#if defined(__AVX512F__)
+
+template <>
+struct Vec<double, 8>
+{
+    __m512d v;
+
+    Vec() noexcept = default;
+    Vec(double x) noexcept : v{_mm512_set1_pd(x)} {}
+    Vec(__m512d x) noexcept : v{x} {}
+
+    static constexpr std::size_t width = 8;
+    static constexpr bool fused_fma = true;
+
+    static Vec load(const double *src) noexcept { return _mm512_loadu_pd(src); }
+    void store(double *dst) const noexcept { _mm512_storeu_pd(dst, v); }
+
+    double operator[](std::size_t i) const noexcept
+    {
+        alignas(64) double tmp[8];
+        _mm512_store_pd(tmp, v);
+        return tmp[i];
+    }
+
+    friend Vec operator+(const Vec &a, const Vec &b) noexcept { return _mm512_add_pd(a.v, b.v); }
+    friend Vec operator*(const Vec &a, const Vec &b) noexcept { return _mm512_mul_pd(a.v, b.v); }
+    friend Vec operator-(const Vec &a, const Vec &b) noexcept { return _mm512_sub_pd(a.v, b.v); }
+    friend Vec operator-(const Vec &a) noexcept { return _mm512_sub_pd(_mm512_setzero_pd(), a.v); }
+    friend Vec keep_rounded(Vec a) noexcept { return opaque(a.v); }
+
+    friend Vec fma(const Vec &a, const Vec &b, const Vec &c) noexcept
+    {
+        return _mm512_fmadd_pd(a.v, b.v, c.v);
+    }
+};
+
+template <>
+struct Vec<float, 16>
+{
+    __m512 v;
+
+    Vec() noexcept = default;
+    Vec(float x) noexcept : v{_mm512_set1_ps(x)} {}
+    Vec(__m512 x) noexcept : v{x} {}
+
+    static constexpr std::size_t width = 16;
+    static constexpr bool fused_fma = true;
+
+    static Vec load(const float *src) noexcept { return _mm512_loadu_ps(src); }
+    void store(float *dst) const noexcept { _mm512_storeu_ps(dst, v); }
+
+    float operator[](std::size_t i) const noexcept
+    {
+        alignas(64) float tmp[16];
+        _mm512_store_ps(tmp, v);
+        return tmp[i];
+    }
+
+    friend Vec operator+(const Vec &a, const Vec &b) noexcept { return _mm512_add_ps(a.v, b.v); }
+    friend Vec operator*(const Vec &a, const Vec &b) noexcept { return _mm512_mul_ps(a.v, b.v); }
+    friend Vec operator-(const Vec &a, const Vec &b) noexcept { return _mm512_sub_ps(a.v, b.v); }
+    friend Vec operator-(const Vec &a) noexcept { return _mm512_sub_ps(_mm512_setzero_ps(), a.v); }
+    friend Vec keep_rounded(Vec a) noexcept { return opaque(a.v); }
+
+    friend Vec fma(const Vec &a, const Vec &b, const Vec &c) noexcept
+    {
+        return _mm512_fmadd_ps(a.v, b.v, c.v);
+    }
+};
+
+#endif // __AVX512F__
+
+template <class T>
+using native_vec = Vec<T, native_width_v<T>>;
+
+/*
+ * Allocator returning memory aligned to Alignment bytes, for containers whose contents are loaded
+ * a full vector register at a time.
+ */
+template <class T, std::size_t Alignment = 64>
+struct AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T));
+    using value_type = T;
+
+    template <class U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <class U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T *p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{Alignment}); }
+
+    template <class U>
+    constexpr bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept
+    {
+        return true;
+    }
+
+    template <class U>
+    constexpr bool operator!=(const AlignedAllocator<U, Alignment> &) const noexcept
+    {
+        return false;
+    }
+};
+
+} // namespace simd
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_SIMD_HPP
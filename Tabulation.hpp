@@ -0,0 +1,172 @@
+/*
+Copyright 2020 Sean McBane
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef POLYNOMIAL_TABULATION_HPP
+#define POLYNOMIAL_TABULATION_HPP
+
+#include "Polynomial.hpp"
+
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Polynomials
+{
+
+/*
+ * Values (and optionally first partial derivatives) of NFuncs functions at NPoints points, laid
+ * out point-major: for each point, the NFuncs values, then the NFuncs derivatives with respect to
+ * variable 0, then variable 1, and so on. A loop over the functions at one point reads contiguous
+ * memory. Each point's row is padded to a whole number of cache lines, so every row starts on one.
+ */
+template <class T, std::size_t NPoints, std::size_t NFuncs, std::size_t NDerivs = 0>
+struct Tabulation
+{
+    static constexpr std::size_t num_points = NPoints;
+    static constexpr std::size_t num_functions = NFuncs;
+    static constexpr std::size_t num_derivatives = NDerivs;
+
+    static constexpr std::size_t alignment = 64;
+
+    // Distance in elements between the starts of consecutive points' rows.
+    static constexpr std::size_t row_stride = [] {
+        constexpr std::size_t unit = alignment / std::gcd(alignment, sizeof(T));
+        return ((NDerivs + 1) * NFuncs + unit - 1) / unit * unit;
+    }();
+
+    alignas(alignment) std::array<T, NPoints * row_stride> entries;
+
+    static constexpr std::size_t offset(std::size_t point, std::size_t deriv, std::size_t func) noexcept
+    {
+        return point * row_stride + deriv * NFuncs + func;
+    }
+
+    constexpr T value(std::size_t point, std::size_t func) const noexcept
+    {
+        return entries[offset(point, 0, func)];
+    }
+
+    constexpr T partial(std::size_t point, std::size_t var, std::size_t func) const noexcept
+    {
+        return entries[offset(point, 1 + var, func)];
+    }
+
+    // Pointers to the NFuncs contiguous values, or derivatives with respect to var, at point.
+    constexpr const T *values(std::size_t point) const noexcept
+    {
+        return entries.data() + offset(point, 0, 0);
+    }
+
+    constexpr const T *partials(std::size_t point, std::size_t var) const noexcept
+    {
+        return entries.data() + offset(point, 1 + var, 0);
+    }
+};
+
+namespace detail
+{
+
+template <class P>
+struct polynomial_nvars;
+
+template <class T, class... Ps>
+struct polynomial_nvars<Polynomial<T, Ps...>>
+    : public std::integral_constant<std::size_t, PowersList<Ps...>::nvars>
+{
+};
+
+template <class T, class P, class X, std::size_t D, std::size_t... Vs>
+constexpr T evaluate_at_point(const P &p, const std::array<X, D> &x, std::index_sequence<Vs...>) noexcept
+{
+    return p(static_cast<T>(x[Vs])...);
+}
+
+template <
+    std::size_t Deriv, class T, std::size_t NPoints, std::size_t NFuncs, std::size_t NDerivs, class P,
+    class X, std::size_t D>
+constexpr void tabulate_column(
+    Tabulation<T, NPoints, NFuncs, NDerivs> &table, std::size_t func, const P &p,
+    const std::array<std::array<X, D>, NPoints> &points) noexcept
+{
+    for (std::size_t q = 0; q < NPoints; ++q)
+    {
+        table.entries[table.offset(q, Deriv, func)] =
+            evaluate_at_point<T>(p, points[q], std::make_index_sequence<D>());
+    }
+}
+
+template <class Table, class P, class Points, std::size_t... Is>
+constexpr void tabulate_function(
+    Table &table, std::size_t func, const P &p, const Points &points, std::index_sequence<Is...>) noexcept
+{
+    tabulate_column<0>(table, func, p, points);
+    (tabulate_column<1 + Is>(table, func, p.template partial<Is>(), points), ...);
+}
+
+template <
+    class T, std::size_t NDerivs, class... Polys, class X, std::size_t D, std::size_t NPoints,
+    std::size_t... Fs>
+constexpr auto tabulate_impl(
+    const std::tuple<Polys...> &family, const std::array<std::array<X, D>, NPoints> &points,
+    std::index_sequence<Fs...>) noexcept
+{
+    static_assert(
+        ((polynomial_nvars<Polys>::value == D) && ...), "Point dimension should match number of variables");
+    Tabulation<T, NPoints, sizeof...(Polys), NDerivs> table{};
+    // Convert first so that evaluation, which is done in the coefficient type, happens in T.
+    (tabulate_function(
+         table, Fs, std::get<Fs>(family) * T(1), points, std::make_index_sequence<NDerivs>()),
+     ...);
+    return table;
+}
+
+template <class X, class... Polys>
+using tabulation_t = std::common_type_t<X, std::decay_t<decltype(std::declval<Polys>().coeffs()[0])>...>;
+
+} // namespace detail
+
+/*
+ * Tabulate each polynomial of family at each of points using the constexpr operator(). Intended to
+ * initialize a static constexpr table, so that no work is done at run time:
+ *
+ *     static constexpr auto basis_at_qps = tabulate(basis, quadrature_points);
+ */
+template <class... Polys, class X, std::size_t D, std::size_t NPoints>
+constexpr auto
+tabulate(const std::tuple<Polys...> &family, const std::array<std::array<X, D>, NPoints> &points) noexcept
+{
+    return detail::tabulate_impl<detail::tabulation_t<X, Polys...>, 0>(
+        family, points, std::index_sequence_for<Polys...>());
+}
+
+// As tabulate, additionally storing partial<I> of each polynomial for I = 0, ..., D - 1.
+template <class... Polys, class X, std::size_t D, std::size_t NPoints>
+constexpr auto tabulate_with_partials(
+    const std::tuple<Polys...> &family, const std::array<std::array<X, D>, NPoints> &points) noexcept
+{
+    return detail::tabulate_impl<detail::tabulation_t<X, Polys...>, D>(
+        family, points, std::index_sequence_for<Polys...>());
+}
+
+} // namespace Polynomials
+
+#endif // POLYNOMIAL_TABULATION_HPP
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""
+Compile-time benchmarks. Generates one translation unit per case, exercising make_poly,
+operator*, operator+ or partial<I> on polynomials with a growing number of terms and variables,
+compiles each with the given compiler and records the wall time and peak resident memory of the
+compilation to a JSON file. With --time-report, GCC's -ftime-report phase timings are recorded as
+well.
+
+Usage: compile_time.py [options] -- <compiler> [compiler args...]
+"""
+
+import argparse
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+from math import comb
+
+OPERATIONS = ('make_poly', 'multiply', 'add', 'partial')
+
+
+def total_degree_terms(nvars, degree):
+    """Exponent tuples of total degree at most degree, in canonical (lexicographic) order."""
+    if nvars == 1:
+        return [(d,) for d in range(degree + 1)]
+    return [(d,) + rest for d in range(degree + 1) for rest in total_degree_terms(nvars - 1, degree - d)]
+
+
+def degree_for(nvars, terms):
+    """The smallest total degree whose dense polynomial in nvars variables has at least terms terms."""
+    degree = 0
+    while comb(nvars + degree, degree) < terms:
+        degree += 1
+    return degree
+
+
+def powers_list(terms):
+    return 'PowersList<{}>'.format(', '.join('Powers<{}>'.format(', '.join(map(str, t))) for t in terms))
+
+
+def generate(operation, nvars, degree):
+    """Source of a translation unit for one case, and the number of terms it is built from."""
+    terms = total_degree_terms(nvars, degree)
+    args = ', '.join('double x{}'.format(v) for v in range(nvars))
+    point = ', '.join('x{}'.format(v) for v in range(nvars))
+    lines = ['#include "Polynomial.hpp"', '', 'using namespace Polynomials;', '']
+
+    if operation == 'make_poly':
+        # Reversed and with every term repeated, so that canonicalization has real work to do.
+        listed = [t for t in reversed(terms) for _ in range(2)]
+        lines += ['using PL = {};'.format(powers_list(listed)), '',
+                  'double bench_case(const std::array<double, PL::size> &cs, {})'.format(args),
+                  '{', '    return make_poly(cs, PL{{}})({});'.format(point), '}']
+    elif operation == 'multiply':
+        lines += ['constexpr auto powers = total_degree_powers<{}, {}>();'.format(nvars, degree), '',
+                  'double bench_case(const std::array<double, powers.size> &cs, {})'.format(args),
+                  '{', '    const auto p = make_poly(cs, powers);',
+                  '    return (p * p)({});'.format(point), '}']
+    elif operation == 'add':
+        # Half of the second operand's terms are shared with the first.
+        shifted = sorted(set((t[0] + 1,) + t[1:] for t in terms))
+        lines += ['constexpr auto powers = total_degree_powers<{}, {}>();'.format(nvars, degree),
+                  'using QL = {};'.format(powers_list(shifted)), '',
+                  'double bench_case(const std::array<double, powers.size> &cs,',
+                  '                  const std::array<double, QL::size> &ds, {})'.format(args),
+                  '{', '    return (make_poly(cs, powers) + make_poly(ds, QL{{}}))({});'.format(point), '}']
+    elif operation == 'partial':
+        lines += ['constexpr auto powers = total_degree_powers<{}, {}>();'.format(nvars, degree), '',
+                  'double bench_case(const std::array<double, powers.size> &cs, {})'.format(args),
+                  '{', '    return partial<{}>(make_poly(cs, powers))({});'.format(nvars - 1, point), '}']
+    return '\n'.join(lines) + '\n', len(terms)
+
+
+def parse_time_report(stderr):
+    """Wall-clock seconds per phase from GCC's -ftime-report output."""
+    phases = {}
+    for line in stderr.splitlines():
+        match = re.match(r'^\s*(.+?)\s*:(?:\s*[\d.]+\s*\(\s*\d+%\)){2}\s*([\d.]+)\s*\(', line)
+        if match:
+            phases[match.group(1)] = float(match.group(2))
+    return phases
+
+
+def compile_case(command, source, timeout):
+    """Compile source, returning the status, wall time, peak RSS in KiB and stderr."""
+    with tempfile.TemporaryFile() as errors:
+        start = time.monotonic()
+        proc = subprocess.Popen(command + [source], stdout=subprocess.DEVNULL, stderr=errors)
+        # Reap the compiler driver with wait4 rather than Popen.wait: its resource usage covers the
+        # driver and the processes it waited for, so ru_maxrss is that of the front end.
+        timed_out = False
+        while True:
+            pid, status, usage = os.wait4(proc.pid, os.WNOHANG)
+            if pid != 0:
+                break
+            if time.monotonic() - start > timeout:
+                timed_out = True
+                proc.kill()
+            time.sleep(0.01)
+        elapsed = time.monotonic() - start
+        proc.returncode = status
+        errors.seek(0)
+        stderr = errors.read().decode(errors='replace')
+
+    if timed_out:
+        result = 'timeout'
+    elif os.WIFSIGNALED(status):
+        result = 'crashed'
+    else:
+        result = 'ok' if os.WEXITSTATUS(status) == 0 else 'failed'
+    return result, elapsed, usage.ru_maxrss, stderr
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--include', default=os.path.dirname(os.path.dirname(os.path.abspath(__file__))),
+                        help='directory containing Polynomial.hpp')
+    parser.add_argument('--output', default='compile_time.json', help='JSON file to write')
+    parser.add_argument('--operations', default=','.join(OPERATIONS),
+                        help='comma-separated subset of ' + ', '.join(OPERATIONS))
+    parser.add_argument('--nvars', default='1,2,3', help='comma-separated variable counts')
+    parser.add_argument('--terms', default='10,40,160,640',
+                        help='comma-separated term counts; each is rounded up to a dense total degree')
+    parser.add_argument('--flags', default='-std=c++17 -O2', help='flags passed to every compilation')
+    parser.add_argument('--timeout', type=float, default=600, help='seconds before a case is abandoned')
+    parser.add_argument('--time-report', action='store_true', help='record -ftime-report phase timings')
+    parser.add_argument('compiler', nargs=argparse.REMAINDER, help='compiler command, after --')
+    args = parser.parse_args()
+
+    compiler = [c for c in args.compiler if c != '--'] or [os.environ.get('CXX', 'c++')]
+    flags = args.flags.split() + ['-I', args.include, '-c', '-o', os.devnull]
+    if args.time_report:
+        flags.append('-ftime-report')
+    command = compiler + flags
+
+    version = subprocess.run(compiler + ['--version'], stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+    version_lines = version.stdout.decode(errors='replace').splitlines()
+    results = {
+        'compiler': command,
+        'compiler_version': version_lines[0] if version_lines else '',
+        'machine': platform.machine(),
+        'cases': [],
+    }
+
+    with tempfile.TemporaryDirectory() as workdir:
+        for operation in args.operations.split(','):
+            if operation not in OPERATIONS:
+                parser.error('unknown operation ' + operation)
+            for nvars in map(int, args.nvars.split(',')):
+                degrees = sorted(set(degree_for(nvars, int(t)) for t in args.terms.split(',')))
+                for degree in degrees:
+                    text, nterms = generate(operation, nvars, degree)
+                    source = os.path.join(workdir, '{}_{}_{}.cpp'.format(operation, nvars, degree))
+                    with open(source, 'w') as f:
+                        f.write(text)
+
+                    status, seconds, rss, stderr = compile_case(command, source, args.timeout)
+                    case = {'operation': operation, 'nvars': nvars, 'degree': degree, 'terms': nterms,
+                            'status': status, 'seconds': round(seconds, 3), 'peak_rss_kib': rss}
+                    if args.time_report:
+                        case['phases'] = parse_time_report(stderr)
+                    if status == 'failed':
+                        # Instantiation contexts spell out whole PowersLists; keep just the diagnostics.
+                        case['errors'] = [l[:500] for l in stderr.splitlines() if 'error:' in l][:10]
+                    results['cases'].append(case)
+
+                    print('{:>10} nvars={} degree={:>3} terms={:>5}  {:>8}  {:8.2f} s  {:>8} KiB'.format(
+                        operation, nvars, degree, nterms, status, seconds, rss if rss is not None else '-'))
+                    sys.stdout.flush()
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2)
+    print('Wrote', args.output)
+    return 0 if all(c['status'] == 'ok' for c in results['cases']) else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,200 @@
+/*
+ * Hardware performance counters for the benchmarks, read through perf_event_open on Linux. Each
+ * event is opened separately, counting user-space work of the calling thread only, so events the
+ * CPU or kernel does not support are skipped rather than disabling the rest. Elsewhere, or when
+ * perf_event_paranoid forbids it, no counters are available and benchmarks report wall time only.
+ */
+
+#ifndef POLYNOMIAL_BENCH_COUNTERS_HPP
+#define POLYNOMIAL_BENCH_COUNTERS_HPP
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace bench
+{
+
+enum Counter : std::size_t
+{
+    Cycles,
+    Instructions,
+    L1DMisses,
+    LLCMisses,
+    VectorOps,
+    NumCounters
+};
+
+// Counter values; a negative value means the counter was not available.
+using CounterValues = std::array<double, NumCounters>;
+
+namespace detail
+{
+
+/*
+ * Raw event counting retired packed (SIMD) floating point instructions of every width, or 0 if
+ * unknown for this CPU. The default is FP_ARITH_INST_RETIRED with all packed umasks, which Intel
+ * cores since Skylake provide; POLYNOMIAL_BENCH_VECTOR_EVENT overrides it with a raw config
+ * value (for example on AMD, or to count a single width).
+ */
+inline std::uint64_t vector_event_config()
+{
+    if (const char *env = std::getenv("POLYNOMIAL_BENCH_VECTOR_EVENT"))
+    {
+        return std::strtoull(env, nullptr, 0);
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    // Vendor string "GenuineIntel".
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid(0, &eax, &ebx, &ecx, &edx) && ebx == 0x756e6547 && edx == 0x49656e69 &&
+        ecx == 0x6c65746e)
+    {
+        return 0xfcc7;
+    }
+#endif
+    return 0;
+}
+
+} // namespace detail
+
+class Counters
+{
+    std::array<int, NumCounters> m_fds;
+    std::string m_error;
+
+#if defined(__linux__)
+    static int open_event(std::uint32_t type, std::uint64_t config)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static constexpr std::uint64_t cache_event(std::uint64_t cache, std::uint64_t result) noexcept
+    {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+    }
+#endif
+
+  public:
+    Counters()
+    {
+        m_fds.fill(-1);
+#if defined(__linux__)
+        m_fds[Cycles] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        if (m_fds[Cycles] < 0)
+        {
+            m_error = std::strerror(errno);
+            if (errno == EACCES || errno == EPERM)
+            {
+                m_error += " (see /proc/sys/kernel/perf_event_paranoid)";
+            }
+            return;
+        }
+        m_fds[Instructions] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        m_fds[L1DMisses] = open_event(
+            PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS));
+        m_fds[LLCMisses] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        if (const std::uint64_t vector_config = detail::vector_event_config())
+        {
+            m_fds[VectorOps] = open_event(PERF_TYPE_RAW, vector_config);
+        }
+#else
+        m_error = "hardware counters are only supported on Linux";
+#endif
+    }
+
+    Counters(const Counters &) = delete;
+    Counters &operator=(const Counters &) = delete;
+
+    ~Counters()
+    {
+#if defined(__linux__)
+        for (int fd : m_fds)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    // Whether any counter could be opened; if not, error() says why.
+    bool available() const noexcept { return m_fds[Cycles] >= 0; }
+    const std::string &error() const noexcept { return m_error; }
+
+    void start() noexcept
+    {
+#if defined(__linux__)
+        for (int fd : m_fds)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void stop() noexcept
+    {
+#if defined(__linux__)
+        for (int fd : m_fds)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+#endif
+    }
+
+    /*
+     * Counts since the last start(), scaled up for any time an event was not scheduled because the
+     * CPU has fewer counters than were requested.
+     */
+    CounterValues read() const noexcept
+    {
+        CounterValues values;
+        values.fill(-1);
+#if defined(__linux__)
+        for (std::size_t c = 0; c < NumCounters; ++c)
+        {
+            std::uint64_t buf[3];
+            if (m_fds[c] >= 0 && ::read(m_fds[c], buf, sizeof(buf)) == sizeof(buf) && buf[2] > 0)
+            {
+                values[c] = static_cast<double>(buf[0]) * buf[1] / buf[2];
+            }
+        }
+#endif
+        return values;
+    }
+};
+
+} // namespace bench
+
+#endif // POLYNOMIAL_BENCH_COUNTERS_HPP
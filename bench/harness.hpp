@@ -0,0 +1,210 @@
+/*
+ * Minimal timing harness for the runtime benchmarks: repeated, calibrated samples of a callable
+ * after a warm-up period, summarized as the median and percentiles of the time per operation, and
+ * a fixed-width table for reporting them. No dependencies beyond the standard library and, for
+ * the optional hardware counters, the Linux perf_event interface.
+ */
+
+#ifndef POLYNOMIAL_BENCH_HARNESS_HPP
+#define POLYNOMIAL_BENCH_HARNESS_HPP
+
+#include "counters.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+// Keep the compiler from discarding the computation of value, or from assuming memory is unchanged.
+template <class T>
+inline void do_not_optimize(const T &value) noexcept
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    const volatile char *sink = reinterpret_cast<const volatile char *>(&value);
+    (void)*sink;
+#endif
+}
+
+struct Options
+{
+    // Time spent running the case before any sample is taken.
+    double warmup_seconds = 0.02;
+    // Each sample repeats the case until it takes at least this long.
+    double min_sample_seconds = 2e-3;
+    std::size_t samples = 21;
+    // Samples run with hardware counters enabled, after (and separately from) the timed samples.
+    std::size_t counted_samples = 5;
+};
+
+/*
+ * Time per operation, in nanoseconds, over the samples of one case. p10 and p90 are the 10th and
+ * 90th percentiles. counters holds hardware event counts per operation, or -1 where not measured.
+ */
+struct Stats
+{
+    double min;
+    double p10;
+    double median;
+    double p90;
+    CounterValues counters;
+};
+
+inline double percentile(const std::vector<double> &sorted, double fraction) noexcept
+{
+    const double position = fraction * (sorted.size() - 1);
+    const std::size_t below = static_cast<std::size_t>(position);
+    const std::size_t above = below + 1 < sorted.size() ? below + 1 : below;
+    return sorted[below] + (position - below) * (sorted[above] - sorted[below]);
+}
+
+/*
+ * Time f(), which performs ops_per_call operations. The number of calls per sample is calibrated
+ * during warm-up so that a sample is long compared to the clock resolution. If counters is given
+ * and available, the hardware events of a further options.counted_samples samples are recorded.
+ */
+template <class F>
+Stats measure(
+    F &&f, std::size_t ops_per_call, const Options &options = Options{}, Counters *counters = nullptr)
+{
+    using clock = std::chrono::steady_clock;
+    const auto seconds_since = [](clock::time_point start) {
+        return std::chrono::duration<double>(clock::now() - start).count();
+    };
+
+    std::size_t calls = 1;
+    const auto warmup_start = clock::now();
+    while (true)
+    {
+        const auto start = clock::now();
+        for (std::size_t c = 0; c < calls; ++c)
+        {
+            f();
+        }
+        const double elapsed = seconds_since(start);
+        if (elapsed < options.min_sample_seconds)
+        {
+            const double scale = elapsed > 0 ? 1.2 * options.min_sample_seconds / elapsed : 10;
+            calls = std::max(calls + 1, static_cast<std::size_t>(calls * scale));
+        }
+        else if (seconds_since(warmup_start) >= options.warmup_seconds)
+        {
+            break;
+        }
+    }
+
+    std::vector<double> times;
+    times.reserve(options.samples);
+    for (std::size_t s = 0; s < options.samples; ++s)
+    {
+        const auto start = clock::now();
+        for (std::size_t c = 0; c < calls; ++c)
+        {
+            f();
+        }
+        times.push_back(seconds_since(start) * 1e9 / (calls * ops_per_call));
+    }
+    std::sort(times.begin(), times.end());
+
+    CounterValues counts;
+    counts.fill(-1);
+    if (counters && counters->available() && options.counted_samples > 0)
+    {
+        const std::size_t total_calls = calls * options.counted_samples;
+        counters->start();
+        for (std::size_t c = 0; c < total_calls; ++c)
+        {
+            f();
+        }
+        counters->stop();
+        counts = counters->read();
+        for (auto &count : counts)
+        {
+            count = count < 0 ? count : count / (total_calls * ops_per_call);
+        }
+    }
+
+    return Stats{
+        times.front(), percentile(times, 0.1), percentile(times, 0.5), percentile(times, 0.9), counts};
+}
+
+/*
+ * One row of the report. flops is the number of floating point operations per operation, or 0 if
+ * that is not meaningful for the case; baseline is the median time per operation of the reference
+ * implementation the case is compared to, or 0 if there is none.
+ */
+struct Result
+{
+    std::string name;
+    std::string type;
+    std::size_t nvars;
+    std::size_t degree;
+    std::size_t terms;
+    Stats stats;
+    double flops;
+    double baseline;
+};
+
+// With counters, the table has further columns of hardware events per operation.
+inline void print_header(bool counters)
+{
+    std::printf(
+        "%-16s %-7s %4s %4s %6s %10s %10s %10s %12s %9s %9s", "case", "type", "vars", "deg", "terms",
+        "ns/op", "p10", "p90", "Mops/s", "GFLOP/s", "speedup");
+    if (counters)
+    {
+        std::printf(
+            " %10s %10s %6s %9s %9s %9s", "cycles/op", "instr/op", "IPC", "L1D/op", "LLC/op", "vec/op");
+    }
+    std::printf("\n");
+}
+
+inline void print_result(const Result &r, bool counters)
+{
+    char gflops[16] = "-";
+    char speedup[16] = "-";
+    if (r.flops > 0)
+    {
+        std::snprintf(gflops, sizeof(gflops), "%.2f", r.flops / r.stats.median);
+    }
+    if (r.baseline > 0)
+    {
+        std::snprintf(speedup, sizeof(speedup), "%.2f", r.baseline / r.stats.median);
+    }
+    std::printf(
+        "%-16s %-7s %4zu %4zu %6zu %10.2f %10.2f %10.2f %12.2f %9s %9s", r.name.c_str(), r.type.c_str(),
+        r.nvars, r.degree, r.terms, r.stats.median, r.stats.p10, r.stats.p90, 1e3 / r.stats.median, gflops,
+        speedup);
+    if (counters)
+    {
+        const auto &c = r.stats.counters;
+        const auto print_count = [](double value, int width, int precision) {
+            if (value < 0)
+            {
+                std::printf(" %*s", width, "-");
+            }
+            else
+            {
+                std::printf(" %*.*f", width, precision, value);
+            }
+        };
+        print_count(c[Cycles], 10, 1);
+        print_count(c[Instructions], 10, 1);
+        print_count(c[Cycles] > 0 && c[Instructions] >= 0 ? c[Instructions] / c[Cycles] : -1, 6, 2);
+        print_count(c[L1DMisses], 9, 3);
+        print_count(c[LLCMisses], 9, 3);
+        print_count(c[VectorOps], 9, 2);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+} // namespace bench
+
+#endif // POLYNOMIAL_BENCH_HARNESS_HPP
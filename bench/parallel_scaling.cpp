@@ -0,0 +1,78 @@
+/*
+ * Scaling of parallel_evaluate_batch with the number of threads. Evaluates a dense trivariate
+ * polynomial of total degree 6 at a large set of points for 1, 2, 4, ... threads up to the
+ * hardware concurrency (or the count given as the first argument), and reports the median time
+ * and speedup over one thread. Build with optimization enabled (meson --buildtype=release).
+ */
+
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace Polynomials;
+
+namespace
+{
+
+template <class F>
+double median_seconds(F &&f, int repetitions)
+{
+    std::vector<double> times;
+    for (int r = 0; r < repetitions; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto stop = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double>(stop - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const std::size_t max_threads =
+        argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t n = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : std::size_t{1} << 24;
+
+    constexpr auto powers = total_degree_powers<3, 6>();
+    std::array<double, powers.size> coeffs{0};
+    for (std::size_t i = 0; i < coeffs.size(); ++i)
+    {
+        coeffs[i] = 1.0 / (i + 1);
+    }
+    const auto poly = make_poly(coeffs, powers);
+
+    std::vector<double> xs(n), ys(n), zs(n), out(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        xs[i] = -1.0 + 2.0 * i / n;
+        ys[i] = 0.5 - 1.0 * i / n;
+        zs[i] = 0.25 * xs[i];
+    }
+
+    std::printf("%zu points, %zu terms\n", n, poly.num_terms);
+    std::printf("%8s %12s %12s %10s\n", "threads", "seconds", "Mpoints/s", "speedup");
+    double base = 0;
+    // Powers of two, then max_threads itself as the last row when it is not one.
+    for (std::size_t nthreads = 1; nthreads <= max_threads;
+         nthreads = nthreads < max_threads && nthreads * 2 > max_threads ? max_threads : nthreads * 2)
+    {
+        ThreadPool pool(nthreads);
+        const double t = median_seconds(
+            [&] {
+                parallel_evaluate_batch(pool, poly, out.data(), n, xs.data(), ys.data(), zs.data());
+            },
+            5);
+        base = nthreads == 1 ? t : base;
+        std::printf("%8zu %12.4f %12.1f %10.2f\n", nthreads, t, n / t * 1e-6, base / t);
+    }
+    return 0;
+}
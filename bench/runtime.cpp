@@ -0,0 +1,364 @@
+/*
+ * Throughput of evaluation, arithmetic and differentiation for dense polynomials (every term of
+ * total degree up to d) in 1, 2 and 3 variables, degrees 1 to 10, with float and double
+ * coefficients. For each case the median, 10th and 90th percentile time per operation are
+ * reported, with operations (evaluations, for the eval cases) per second.
+ *
+ * Evaluation cases compute a block of points per call and are compared to eval-baseline, a
+ * hand-written nested Horner loop over the same coefficients. Their GFLOP/s counts the additions
+ * and multiplications the strategy actually performs, so strategies doing less work can run
+ * faster at a lower rate. eval-interleaved evaluates groups of 4 points in lockstep, which is
+ * meant for builds without SIMD (e.g. -fno-tree-vectorize), where the other cases are not
+ * vectorized across points. eval-comp-batch runs the compensated scheme of eval-compensated on
+ * SIMD lanes through evaluate_batch. Products count 2 * N * M operations and partials one per term.
+ * The latency cases chain univariate evaluations of degree 8 to 32, each point depending on the last
+ * result, to compare the dependent chains of the Horner and Estrin schemes.
+ *
+ * Usage: bench [--counters] [filter]; only cases whose "case/type/vars/degree" label contains
+ * filter are run, e.g. "eval-horner/double/3/". With --counters, hardware events per operation
+ * (per point, for the eval cases) are reported as well where perf_event_open is permitted: cycles,
+ * instructions, IPC, L1D and last-level cache misses and packed floating point instructions. Build
+ * with optimization enabled (meson --buildtype=release).
+ */
+
+#include "harness.hpp"
+
+#include "Batch.hpp"
+#include "Polynomial.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Polynomials;
+
+namespace
+{
+
+// Points evaluated per call; small enough that inputs and outputs stay in L1.
+constexpr std::size_t npoints = 512;
+constexpr std::size_t max_degree = 10;
+
+template <class T>
+const char *type_name();
+
+template <>
+const char *type_name<float>()
+{
+    return "float";
+}
+
+template <>
+const char *type_name<double>()
+{
+    return "double";
+}
+
+/*
+ * Nested Horner evaluation of a dense polynomial of total degree `degree` in NVars variables, with
+ * coefficients in canonical (lexicographic) order; c points one past the last coefficient and is
+ * moved back past those consumed.
+ */
+template <std::size_t NVars, class T>
+T horner_dense(const T *&c, unsigned degree, const T *x) noexcept
+{
+    if constexpr (NVars == 1)
+    {
+        T r = *--c;
+        for (unsigned k = degree; k > 0; --k)
+        {
+            r = r * x[0] + *--c;
+        }
+        return r;
+    }
+    else
+    {
+        T r = horner_dense<NVars - 1>(c, 0, x + 1);
+        for (unsigned k = 1; k <= degree; ++k)
+        {
+            r = r * x[0] + horner_dense<NVars - 1>(c, k, x + 1);
+        }
+        return r;
+    }
+}
+
+// Operations performed by horner_dense.
+template <std::size_t NVars>
+constexpr std::size_t baseline_flops(unsigned degree) noexcept
+{
+    if constexpr (NVars == 1)
+    {
+        return 2 * degree;
+    }
+    else
+    {
+        std::size_t flops = 0;
+        for (unsigned k = 0; k <= degree; ++k)
+        {
+            flops += baseline_flops<NVars - 1>(k) + (k > 0 ? 2 : 0);
+        }
+        return flops;
+    }
+}
+
+template <class T, std::size_t NVars>
+struct Points
+{
+    std::array<std::vector<T>, NVars> coords;
+    std::vector<T> out;
+
+    Points() : out(npoints)
+    {
+        for (std::size_t v = 0; v < NVars; ++v)
+        {
+            coords[v].resize(npoints);
+            for (std::size_t i = 0; i < npoints; ++i)
+            {
+                coords[v][i] = T(-1) + T(2) * ((i * (2 * v + 3)) % npoints) / npoints;
+            }
+        }
+    }
+
+    template <class F, std::size_t... Vs>
+    void evaluate(F &&f, std::index_sequence<Vs...>)
+    {
+        for (std::size_t i = 0; i < npoints; ++i)
+        {
+            out[i] = f(coords[Vs][i]...);
+        }
+        bench::do_not_optimize(out.front());
+    }
+
+    // As evaluate, for f taking the output array and one input array per variable.
+    template <class F, std::size_t... Vs>
+    void evaluate_arrays(F &&f, std::index_sequence<Vs...>)
+    {
+        f(out.data(), coords[Vs].data()...);
+        bench::do_not_optimize(out.front());
+    }
+
+    /*
+     * As evaluate for one variable, but each point depends on the previous result (through a
+     * multiplication by zero the compiler cannot see), so the time per point is the latency of an
+     * evaluation rather than its throughput.
+     */
+    template <class F>
+    void chain(F &&f, T zero)
+    {
+        T r = 0;
+        for (std::size_t i = 0; i < npoints; ++i)
+        {
+            r = f(coords[0][i] + zero * r);
+        }
+        out[0] = r;
+        bench::do_not_optimize(out.front());
+    }
+};
+
+constexpr std::size_t total_ops(const OpCount &count) noexcept
+{
+    return count.multiplications + count.additions;
+}
+
+class Runner
+{
+    std::string m_filter;
+    bench::Options m_options;
+    std::unique_ptr<bench::Counters> m_counters;
+
+  public:
+    Runner(std::string filter, bool counters) : m_filter{std::move(filter)}
+    {
+        if (counters)
+        {
+            m_counters = std::make_unique<bench::Counters>();
+            if (!m_counters->available())
+            {
+                std::fprintf(
+                    stderr, "Hardware counters unavailable: %s\n", m_counters->error().c_str());
+                m_counters.reset();
+            }
+        }
+    }
+
+    bool counters() const noexcept { return m_counters != nullptr; }
+
+    template <class T, class F>
+    double run(const char *name, std::size_t nvars, std::size_t degree, std::size_t terms, std::size_t ops,
+               double flops, double baseline, F &&f)
+    {
+        const std::string label = std::string(name) + "/" + type_name<T>() + "/" + std::to_string(nvars) +
+                                  "/" + std::to_string(degree);
+        if (label.find(m_filter) == std::string::npos)
+        {
+            return 0;
+        }
+        const bench::Stats stats = bench::measure(f, ops, m_options, m_counters.get());
+        bench::print_result(
+            bench::Result{name, type_name<T>(), nvars, degree, terms, stats, flops, baseline}, counters());
+        return stats.median;
+    }
+};
+
+template <class T, std::size_t NVars, std::size_t Degree>
+void run_shape(Runner &runner)
+{
+    constexpr auto powers = total_degree_powers<NVars, Degree>();
+    constexpr auto half_powers = total_degree_powers<NVars, (Degree + 1) / 2>();
+    constexpr std::size_t nterms = decltype(powers)::size;
+    constexpr auto seq = std::make_index_sequence<NVars>();
+
+    std::array<T, nterms> coeffs{};
+    for (std::size_t i = 0; i < nterms; ++i)
+    {
+        coeffs[i] = T(1) / T(i + 2);
+    }
+    std::array<T, decltype(half_powers)::size> half_coeffs{};
+    for (std::size_t i = 0; i < half_coeffs.size(); ++i)
+    {
+        half_coeffs[i] = T(1) - T(1) / T(i + 3);
+    }
+    const auto p = make_poly(coeffs, powers);
+    const auto q = make_poly(half_coeffs, half_powers);
+    Points<T, NVars> points;
+
+    const double base = runner.run<T>(
+        "eval-baseline", NVars, Degree, nterms, npoints, baseline_flops<NVars>(Degree), 0, [&] {
+            points.evaluate(
+                [&](const auto &...xs) {
+                    const T x[] = {xs...};
+                    const T *c = coeffs.data() + nterms;
+                    return horner_dense<NVars>(c, Degree, x);
+                },
+                seq);
+        });
+    runner.run<T>(
+        "eval-operator()", NVars, Degree, nterms, npoints, total_ops(op_count(Naive{}, powers)), base,
+        [&] { points.evaluate([&](const auto &...xs) { return p(xs...); }, seq); });
+    runner.run<T>(
+        "eval-horner", NVars, Degree, nterms, npoints, total_ops(op_count(Horner<>{}, powers)), base,
+        [&] { points.evaluate([&](const auto &...xs) { return p.evaluate(Horner<>{}, xs...); }, seq); });
+    runner.run<T>(
+        "eval-interleaved", NVars, Degree, nterms, npoints, total_ops(op_count(Naive{}, powers)), base,
+        [&] {
+            points.evaluate_arrays(
+                [&](T *out, const auto *...xs) { evaluate_interleaved<4>(p, out, npoints, xs...); }, seq);
+        });
+    runner.run<T>(
+        "eval-estrin", NVars, Degree, nterms, npoints, total_ops(op_count(Estrin<>{}, powers)), base,
+        [&] { points.evaluate([&](const auto &...xs) { return p.evaluate(Estrin<>{}, xs...); }, seq); });
+    runner.run<T>(
+        "eval-powertable", NVars, Degree, nterms, npoints, total_ops(op_count(PowerTable{}, powers)),
+        base, [&] {
+            points.evaluate([&](const auto &...xs) { return p.evaluate(PowerTable{}, xs...); }, seq);
+        });
+    runner.run<T>("eval-compensated", NVars, Degree, nterms, npoints, 0, base, [&] {
+        points.evaluate([&](const auto &...xs) { return p.evaluate(CompensatedHorner<T>{}, xs...); }, seq);
+    });
+    runner.run<T>("eval-comp-batch", NVars, Degree, nterms, npoints, 0, base, [&] {
+        points.evaluate_arrays(
+            [&](T *out, const auto *...xs) {
+                evaluate_batch(CompensatedHorner<T>{}, p, out, npoints, xs...);
+            },
+            seq);
+    });
+
+    bench::do_not_optimize(p);
+    bench::do_not_optimize(q);
+    runner.run<T>("add", NVars, Degree, nterms, 1, 0, 0, [&] { bench::do_not_optimize(p + q); });
+    runner.run<T>("multiply", NVars, Degree, nterms, 1, 2.0 * p.num_terms * q.num_terms, 0, [&] {
+        bench::do_not_optimize(p * q);
+    });
+    runner.run<T>("partial", NVars, Degree, nterms, 1, nterms, 0, [&] {
+        bench::do_not_optimize(partial<NVars - 1>(p));
+    });
+}
+
+/*
+ * Latency of evaluating a univariate polynomial of the given degree, where Horner's scheme is a
+ * dependent chain of Degree multiply-adds and Estrin's a tree of depth log2(Degree). Speedups are
+ * relative to Horner.
+ */
+template <class T, std::size_t Degree>
+void run_latency(Runner &runner)
+{
+    constexpr auto powers = total_degree_powers<1, Degree>();
+    constexpr std::size_t nterms = decltype(powers)::size;
+    std::array<T, nterms> coeffs{};
+    for (std::size_t i = 0; i < nterms; ++i)
+    {
+        coeffs[i] = T(1) / T(i + 2);
+    }
+    const auto p = make_poly(coeffs, powers);
+    Points<T, 1> points;
+    static volatile T zero_source = 0;
+    const T zero = zero_source;
+
+    const double horner = runner.run<T>(
+        "latency-horner", 1, Degree, nterms, npoints, 0, 0,
+        [&] { points.chain([&](T x) { return p.evaluate(Horner<>{}, x); }, zero); });
+    runner.run<T>("latency-baseline", 1, Degree, nterms, npoints, 0, horner, [&] {
+        points.chain(
+            [&](T x) {
+                const T *c = coeffs.data() + nterms;
+                return horner_dense<1>(c, Degree, &x);
+            },
+            zero);
+    });
+    runner.run<T>(
+        "latency-estrin", 1, Degree, nterms, npoints, 0, horner,
+        [&] { points.chain([&](T x) { return p.evaluate(Estrin<>{}, x); }, zero); });
+    runner.run<T>(
+        "latency-operator()", 1, Degree, nterms, npoints, 0, horner,
+        [&] { points.chain([&](T x) { return p(x); }, zero); });
+}
+
+template <class T, std::size_t NVars, std::size_t... Ds>
+void run_degrees(Runner &runner, std::index_sequence<Ds...>)
+{
+    (run_shape<T, NVars, Ds + 1>(runner), ...);
+}
+
+template <class T>
+void run_type(Runner &runner)
+{
+    run_degrees<T, 1>(runner, std::make_index_sequence<max_degree>());
+    run_degrees<T, 2>(runner, std::make_index_sequence<max_degree>());
+    run_degrees<T, 3>(runner, std::make_index_sequence<max_degree>());
+    run_latency<T, 8>(runner);
+    run_latency<T, 12>(runner);
+    run_latency<T, 16>(runner);
+    run_latency<T, 24>(runner);
+    run_latency<T, 32>(runner);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    bool counters = false;
+    const char *filter = "";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--counters") == 0)
+        {
+            counters = true;
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+
+    Runner runner(filter, counters);
+    std::printf("%zu points per evaluation call\n", npoints);
+    bench::print_header(runner.counters());
+    run_type<float>(runner);
+    run_type<double>(runner);
+    return 0;
+}
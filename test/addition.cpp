@@ -71,4 +71,23 @@ TEST_CASE("Add two muli-variable polynomials with different powers")
     REQUIRE(result.coeffs()[1] == 2);
     REQUIRE(result.coeffs()[2] == -3);
     REQUIRE(result.coeffs()[3] == 4);
-}
\ No newline at end of file
+}
+
+TEST_CASE("In-place addition of a polynomial with a subset of the terms")
+{
+    constexpr auto powers = Polynomials::total_degree_powers<2, 2>();
+    auto acc = make_poly(std::array{1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, powers);
+    const auto addend = make_poly(std::array{10.0, 20.0}, PowersList<Powers<2, 0>, Powers<0, 1>>{});
+    const auto expected = acc + addend;
+    static_assert(std::is_same_v<decltype(expected), const std::decay_t<decltype(acc)>>);
+
+    acc += addend;
+    REQUIRE(acc.coeffs() == expected.coeffs());
+
+    constexpr auto folded = []() {
+        auto p = make_poly(std::array{1, 1, 1}, PowersList<Powers<0>, Powers<1>, Powers<2>>{});
+        p += make_poly(std::array{5}, PowersList<Powers<1>>{});
+        return p;
+    }();
+    static_assert(folded.coeffs()[0] == 1 && folded.coeffs()[1] == 6 && folded.coeffs()[2] == 1);
+}
@@ -0,0 +1,241 @@
+#include "Batch.hpp"
+#include "doctest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using Polynomials::evaluate_batch;
+using Polynomials::make_poly;
+using Polynomials::Powers;
+using Polynomials::PowersList;
+
+TEST_CASE("Batched evaluation matches pointwise evaluation")
+{
+    constexpr auto powers = PowersList<Powers<3, 0>, Powers<0, 3>, Powers<2, 1>, Powers<1, 2>,
+        Powers<2, 0>, Powers<0, 2>, Powers<1, 1>, Powers<1, 0>, Powers<0, 1>, Powers<0, 0>>{};
+    constexpr std::array<double, powers.size> coeffs{2, 1, -3, 4, 0.5, 5, 1, 1, 2, 1};
+    constexpr auto poly = make_poly(coeffs, powers);
+
+    SUBCASE("Number of points not a multiple of the vector width")
+    {
+        constexpr std::size_t n = 37;
+        std::vector<double> xs(n), ys(n), out(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            xs[i] = 0.125 * i - 2;
+            ys[i] = 1.5 - 0.0625 * i;
+        }
+        evaluate_batch(poly, out.data(), n, xs.data(), ys.data());
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(out[i] == doctest::Approx(poly(xs[i], ys[i])));
+        }
+    }
+
+    SUBCASE("Fewer points than the vector width")
+    {
+        const double xs[] = {1.0, 2.0};
+        const double ys[] = {2.0, 2.0};
+        double out[] = {0.0, 0.0};
+        evaluate_batch(poly, out, 2, xs, ys);
+
+        REQUIRE(out[0] == doctest::Approx(poly(1.0, 2.0)));
+        REQUIRE(out[1] == doctest::Approx(poly(2.0, 2.0)));
+    }
+}
+
+TEST_CASE("Batched evaluation with float inputs and integer coefficients")
+{
+    constexpr auto powers = PowersList<Powers<0>, Powers<1>, Powers<2>, Powers<5>>{};
+    constexpr auto poly = make_poly(std::tuple(1, -2, 3, 1), powers);
+
+    std::vector<float> xs(19), out(19);
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+        xs[i] = 0.25f * i;
+    }
+    evaluate_batch(poly, out.data(), xs.size(), xs.data());
+
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+        const float x = xs[i];
+        REQUIRE(out[i] == doctest::Approx(1 - 2 * x + 3 * x * x + x * x * x * x * x));
+    }
+}
+
+TEST_CASE("Batched evaluation of float data accumulated in double")
+{
+    constexpr auto powers = PowersList<Powers<5>, Powers<4>, Powers<3>, Powers<2>, Powers<1>, Powers<0>>{};
+    constexpr auto poly = make_poly(
+        std::array<float, 6>{1.0f, -3.75f, 5.625f, -4.21875f, 1.58203125f, -0.2373046875f}, powers);
+
+    std::vector<float> xs(21);
+    std::vector<double> out(21);
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+        xs[i] = 0.8f + 0.025f * i;
+    }
+    evaluate_batch(Polynomials::Accumulate<double>{}, poly, out.data(), xs.size(), xs.data());
+
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+        const double exact = std::pow(static_cast<double>(xs[i]) - 0.75, 5);
+        REQUIRE(out[i] == doctest::Approx(exact).epsilon(1e-8));
+    }
+}
+
+TEST_CASE("Batched evaluation with an accumulation strategy")
+{
+    constexpr auto powers = PowersList<Powers<3, 0>, Powers<0, 3>, Powers<2, 1>, Powers<1, 2>,
+        Powers<2, 0>, Powers<0, 2>, Powers<1, 1>, Powers<1, 0>, Powers<0, 1>, Powers<0, 0>>{};
+    constexpr auto poly =
+        make_poly(std::array<float, powers.size>{2, 1, -3, 4, 0.5, 5, 1, 1, 2, 1}, powers);
+
+    constexpr std::size_t n = 23;
+    std::vector<float> xs(n), ys(n);
+    std::vector<double> horner(n), estrin(n), table(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        xs[i] = 0.125f * i - 1.5f;
+        ys[i] = 0.75f - 0.0625f * i;
+    }
+    evaluate_batch(Polynomials::Accumulate<double>{}, poly, horner.data(), n, xs.data(), ys.data());
+    evaluate_batch(
+        Polynomials::Accumulate<double, Polynomials::Estrin<1, 0>>{}, poly, estrin.data(), n, xs.data(),
+        ys.data());
+    evaluate_batch(
+        Polynomials::Accumulate<double, Polynomials::PowerTable>{}, poly, table.data(), n, xs.data(),
+        ys.data());
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double expected = poly.evaluate(Polynomials::Accumulate<double>{}, xs[i], ys[i]);
+        REQUIRE(horner[i] == doctest::Approx(expected).epsilon(1e-14));
+        REQUIRE(estrin[i] == doctest::Approx(expected).epsilon(1e-14));
+        REQUIRE(table[i] == doctest::Approx(expected).epsilon(1e-14));
+    }
+}
+
+TEST_CASE("Compensated batched evaluation of float data")
+{
+    // (x - 0.75)^9, whose float coefficients are exact; Horner in float loses most digits near
+    // the root, while the compensated scheme stays close to double accuracy.
+    constexpr auto powers = Polynomials::total_degree_powers<1, 9>();
+    constexpr auto poly = make_poly(
+        std::array<float, 10>{-0.075084686279296875f, 0.901016235351562500f, -4.805419921875f,
+                              14.9501953125f, -29.900390625f, 39.8671875f, -35.4375f, 20.25f,
+                              -6.75f, 1.0f},
+        powers);
+
+    constexpr std::size_t n = 25;
+    std::vector<float> xs(n), plain(n), compensated(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        xs[i] = 1.25f + 0.03125f * i;
+    }
+    evaluate_batch(poly, plain.data(), n, xs.data());
+    evaluate_batch(Polynomials::CompensatedHorner<float>{}, poly, compensated.data(), n, xs.data());
+
+    double plain_error = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double exact = std::pow(static_cast<double>(xs[i]) - 0.75, 9);
+        REQUIRE(compensated[i] == doctest::Approx(exact).epsilon(1e-6));
+        plain_error = std::max(plain_error, std::abs(plain[i] - exact) / exact);
+    }
+    REQUIRE(plain_error > 1e-4);
+}
+
+TEST_CASE("Interleaved evaluation of groups of points")
+{
+    constexpr auto powers = PowersList<Powers<3, 0, 1>, Powers<0, 2, 0>, Powers<1, 1, 1>, Powers<0, 0, 0>,
+        Powers<2, 0, 2>>{};
+    constexpr auto poly = make_poly(std::array{0.5, -2.0, 3.0, 1.0, -0.25}, powers);
+
+    SUBCASE("A single group")
+    {
+        const std::array<double, 4> xs{0.5, -1.0, 2.0, 0.0};
+        const std::array<double, 4> ys{1.0, 0.25, -3.0, 2.0};
+        const std::array<float, 4> zs{-1.0f, 2.0f, 0.5f, 1.5f};
+        std::array<double, 4> values{};
+        Polynomials::evaluate_group<4>(poly, values.data(), xs.data(), ys.data(), zs.data());
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            REQUIRE(values[i] == doctest::Approx(poly(xs[i], ys[i], zs[i])));
+        }
+    }
+
+    SUBCASE("Group sizes that do not divide the number of points")
+    {
+        constexpr std::size_t n = 29;
+        std::vector<double> xs(n), ys(n), zs(n), out4(n), out8(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            xs[i] = 0.125 * i - 1.5;
+            ys[i] = 1.0 - 0.0625 * i;
+            zs[i] = 0.03125 * i;
+        }
+        Polynomials::evaluate_interleaved<4>(poly, out4.data(), n, xs.data(), ys.data(), zs.data());
+        Polynomials::evaluate_interleaved<8>(poly, out8.data(), n, xs.data(), ys.data(), zs.data());
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            REQUIRE(out4[i] == doctest::Approx(poly(xs[i], ys[i], zs[i])));
+            REQUIRE(out8[i] == doctest::Approx(poly(xs[i], ys[i], zs[i])));
+        }
+    }
+}
+
+TEST_CASE("Monomial values for a PowersList")
+{
+    using Polynomials::MatrixLayout;
+    using Polynomials::monomials;
+
+    constexpr auto powers =
+        PowersList<Powers<1, 1>, Powers<0, 0>, Powers<2, 0>, Powers<0, 3>, Powers<1, 1>>{};
+    constexpr std::array<double, powers.size> coeffs{1.5, -1, 2, 0.25, 1};
+    constexpr auto poly = make_poly(coeffs, powers);
+
+    SUBCASE("Single point, ordered like Polynomial::coeffs()")
+    {
+        constexpr auto values = monomials(powers, 2.0, 3.0);
+        static_assert(values.size() == poly.num_terms);
+        static_assert(values[0] == 1 && values[1] == 27 && values[2] == 6 && values[3] == 4);
+
+        double sum = 0;
+        for (std::size_t j = 0; j < values.size(); ++j)
+        {
+            sum += values[j] * poly.coeffs()[j];
+        }
+        REQUIRE(sum == doctest::Approx(poly(2.0, 3.0)));
+    }
+
+    SUBCASE("Vandermonde matrix in both layouts")
+    {
+        constexpr std::size_t n = 150;
+        constexpr std::size_t nterms = poly.num_terms;
+        std::vector<double> xs(n), ys(n), rows(n * nterms), cols(n * nterms);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            xs[i] = 0.01 * i - 0.5;
+            ys[i] = 1.0 - 0.02 * i;
+        }
+        monomials(powers, MatrixLayout::RowMajor, rows.data(), n, xs.data(), ys.data());
+        monomials(powers, MatrixLayout::ColumnMajor, cols.data(), n, xs.data(), ys.data());
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto expected = monomials(powers, xs[i], ys[i]);
+            double sum = 0;
+            for (std::size_t j = 0; j < nterms; ++j)
+            {
+                REQUIRE(rows[i * nterms + j] == expected[j]);
+                REQUIRE(cols[j * n + i] == expected[j]);
+                sum += rows[i * nterms + j] * poly.coeffs()[j];
+            }
+            REQUIRE(sum == doctest::Approx(poly(xs[i], ys[i])));
+        }
+    }
+}
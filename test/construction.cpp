@@ -5,6 +5,27 @@ using Polynomials::make_poly;
 using Polynomials::Powers;
 using Polynomials::PowersList;
 
+namespace
+{
+
+// The 1891 monomials of total degree <= 60 in two variables, in reverse order and repeated.
+struct ReversedWithDuplicates
+{
+    using Base = Polynomials::detail::TotalDegreeTable<2, 60>;
+    static constexpr std::size_t size = 2 * Base::size;
+
+    static constexpr auto value = []() {
+        std::array<std::array<unsigned, 2>, size> table{};
+        for (std::size_t k = 0; k < size; ++k)
+        {
+            table[k] = Base::value[Base::size - 1 - k % Base::size];
+        }
+        return table;
+    }();
+};
+
+} // namespace
+
 TEST_CASE("Construct a polynomial with coefficient array")
 {
     SUBCASE("Only a single coefficient")
@@ -133,4 +154,33 @@ TEST_CASE("Construct a polynomial with a coefficient tuple")
         REQUIRE(poly.coeffs()[2] == 6);
         REQUIRE(poly.coeffs()[3] == 6);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Canonicalizing a list with thousands of terms")
+{
+    using Table = ReversedWithDuplicates;
+    constexpr auto powers =
+        Polynomials::detail::powers_from_table<Table>(std::make_index_sequence<Table::size>());
+    constexpr auto canonical = Polynomials::unique_and_sorted(powers);
+    static_assert(std::is_same_v<
+                  std::decay_t<decltype(canonical.second)>,
+                  std::decay_t<decltype(Polynomials::total_degree_powers<2, 60>())>>);
+
+    constexpr auto indices = Polynomials::detail::sequence_to_array(canonical.first);
+    static_assert(indices.size() == Table::size);
+    static_assert(indices[0] == Table::Base::size - 1);
+    static_assert(indices[Table::size - 1] == 0);
+    static_assert(indices[Table::Base::size] == Table::Base::size - 1);
+
+    std::array<double, Table::size> coeffs{};
+    for (std::size_t k = 0; k < coeffs.size(); ++k)
+    {
+        coeffs[k] = k < Table::Base::size ? 1.0 : 2.0;
+    }
+    const auto poly = make_poly(coeffs, powers);
+    static_assert(poly.num_terms == Table::Base::size);
+    for (auto c : poly.coeffs())
+    {
+        REQUIRE(c == 3.0);
+    }
+}
@@ -0,0 +1,110 @@
+#include "Expressions.hpp"
+#include "doctest.hpp"
+
+using namespace Polynomials;
+
+namespace
+{
+
+constexpr auto p =
+    make_poly(std::array{1.0, 2.0, -1.0}, PowersList<Powers<0, 0>, Powers<1, 0>, Powers<1, 1>>{});
+constexpr auto q = make_poly(std::array{0.5, 3.0}, PowersList<Powers<0, 1>, Powers<1, 0>>{});
+constexpr auto r = make_poly(std::array{-2.0, 1.0}, PowersList<Powers<0, 0>, Powers<0, 2>>{});
+constexpr auto s = make_poly(std::array{4.0}, PowersList<Powers<1, 1>>{});
+
+template <class L, class R, class = void>
+struct can_add : std::false_type
+{
+};
+
+template <class L, class R>
+struct can_add<L, R, std::void_t<decltype(std::declval<L>() + std::declval<R>())>> : std::true_type
+{
+};
+
+template <class L, class R, class = void>
+struct can_multiply : std::false_type
+{
+};
+
+template <class L, class R>
+struct can_multiply<L, R, std::void_t<decltype(std::declval<L>() * std::declval<R>())>> : std::true_type
+{
+};
+
+} // namespace
+
+TEST_CASE("Lazy polynomial expressions")
+{
+    const auto e = 2.0 * lazy(p) + 3.0 * lazy(q) * r - s;
+    const auto expected = p * 2.0 + q * 3.0 * r + s * -1.0;
+
+    SUBCASE("Evaluation without expansion")
+    {
+        for (double x : {-1.0, 0.25, 2.0})
+        {
+            for (double y : {-0.5, 1.5})
+            {
+                REQUIRE(e(x, y) == doctest::Approx(expected(x, y)));
+                REQUIRE(e(x, y) == doctest::Approx(2 * p(x, y) + 3 * q(x, y) * r(x, y) - s(x, y)));
+            }
+        }
+
+        // The leaves evaluated naively, two scalings, one product and two additions.
+        constexpr auto cost = decltype(e)::cost();
+        constexpr OpCount leaves[] = {
+            std::decay_t<decltype(p)>::cost(Naive{}), std::decay_t<decltype(q)>::cost(Naive{}),
+            std::decay_t<decltype(r)>::cost(Naive{}), std::decay_t<decltype(s)>::cost(Naive{})};
+        static_assert(
+            cost.multiplications == leaves[0].multiplications + leaves[1].multiplications +
+                                        leaves[2].multiplications + leaves[3].multiplications + 3);
+        static_assert(
+            cost.additions ==
+            leaves[0].additions + leaves[1].additions + leaves[2].additions + leaves[3].additions + 2);
+    }
+
+    SUBCASE("Materialization canonicalizes once")
+    {
+        const auto m = e.materialize();
+        static_assert(std::is_same_v<std::decay_t<decltype(m)>, std::decay_t<decltype(expected)>>);
+        for (std::size_t i = 0; i < m.num_terms; ++i)
+        {
+            REQUIRE(m.coeffs()[i] == doctest::Approx(expected.coeffs()[i]));
+        }
+
+        std::decay_t<decltype(expected)> assigned = e;
+        REQUIRE(assigned.coeffs() == m.coeffs());
+
+        // Terms shared between the operands of a sum are collected.
+        const auto doubled = (lazy(p) + p).materialize();
+        static_assert(doubled.num_terms == 3);
+        REQUIRE(doubled.coeffs() == (p * 2.0).coeffs());
+    }
+
+    SUBCASE("Arithmetic on polynomials alone stays eager")
+    {
+        static_assert(detail::is_polynomial<std::decay_t<decltype(p + q)>>::value);
+        static_assert(detail::is_polynomial<std::decay_t<decltype(p * q)>>::value);
+        static_assert(detail::is_polynomial<std::decay_t<decltype(p * 2.0)>>::value);
+    }
+
+    SUBCASE("Temporary polynomials are rejected as operands")
+    {
+        using Lazy = decltype(lazy(p));
+        using Poly = std::decay_t<decltype(q)>;
+        static_assert(can_add<Lazy, const Poly &>::value && can_add<const Poly &, Lazy>::value);
+        static_assert(!can_add<Lazy, Poly>::value && !can_add<Poly, Lazy>::value);
+        static_assert(can_multiply<Lazy, const Poly &>::value && can_multiply<const Poly &, Lazy>::value);
+        static_assert(!can_multiply<Lazy, Poly>::value && !can_multiply<Poly, Lazy>::value);
+        static_assert(!can_add<Lazy, decltype(q * 2.0)>::value);
+    }
+
+    SUBCASE("Compile-time expressions")
+    {
+        constexpr auto m = (lazy(p) * q - lazy(r)).materialize();
+        constexpr auto direct = p * q + r * -1.0;
+        static_assert(m.num_terms == direct.num_terms);
+        static_assert(m.coeffs()[0] == direct.coeffs()[0] && m.coeffs()[7] == direct.coeffs()[7]);
+        static_assert((lazy(p) * q - lazy(r))(2.0, 3.0) == direct(2.0, 3.0));
+    }
+}
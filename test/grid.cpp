@@ -0,0 +1,66 @@
+#include "Grid.hpp"
+#include "doctest.hpp"
+
+#include <array>
+#include <vector>
+
+using namespace Polynomials;
+
+TEST_CASE("Evaluation on a tensor-product grid")
+{
+    SUBCASE("Dense polynomial in three variables")
+    {
+        constexpr auto powers = total_degree_powers<3, 4>();
+        std::array<double, powers.size> coeffs{};
+        for (std::size_t i = 0; i < coeffs.size(); ++i)
+        {
+            coeffs[i] = 0.5 + 0.25 * (i % 5) - 0.375 * (i % 2);
+        }
+        const auto poly = make_poly(coeffs, powers);
+
+        const std::vector<double> xs{-0.75, 0.0, 0.5, 1.25};
+        const std::array<double, 3> ys{-1.0, 0.25, 0.875};
+        const double zs[] = {-0.5, 0.125, 0.625, 1.0, 1.5};
+        std::vector<double> out(4 * 3 * 5);
+        evaluate_on_grid(poly, out.data(), xs, ys, zs);
+
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                for (std::size_t k = 0; k < 5; ++k)
+                {
+                    REQUIRE(out[(i * 3 + j) * 5 + k] == doctest::Approx(poly(xs[i], ys[j], zs[k])));
+                }
+            }
+        }
+    }
+
+    SUBCASE("Sparse polynomial in single precision")
+    {
+        constexpr auto poly = make_poly(
+            std::tuple(3.0f, -2.0f, 1.0f), PowersList<Powers<5, 0>, Powers<0, 3>, Powers<2, 1>>{});
+        const std::vector<float> xs{1.0f, 2.0f, -1.5f};
+        const std::vector<float> ys{0.5f, -2.0f};
+        std::array<float, 6> out{};
+        evaluate_on_grid(poly, out.data(), xs, ys);
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t j = 0; j < 2; ++j)
+            {
+                REQUIRE(out[i * 2 + j] == doctest::Approx(poly(xs[i], ys[j])));
+            }
+        }
+    }
+
+    SUBCASE("Univariate polynomial")
+    {
+        constexpr auto poly =
+            make_poly(std::array{1.0, 2.0, 3.0}, PowersList<Powers<0>, Powers<1>, Powers<2>>{});
+        const std::vector<double> xs{0.0, 1.0, 2.0};
+        std::vector<double> out(3);
+        evaluate_on_grid(poly, out.data(), xs);
+        REQUIRE(out == std::vector<double>{1.0, 6.0, 17.0});
+    }
+}
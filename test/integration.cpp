@@ -0,0 +1,60 @@
+#include "Integration.hpp"
+#include "doctest.hpp"
+
+using namespace Polynomials;
+
+TEST_CASE("Exact integration over reference elements")
+{
+    SUBCASE("Reference interval")
+    {
+        constexpr auto poly = make_poly(
+            std::array{3.0, 2.0, -1.5, 5.0}, PowersList<Powers<0>, Powers<1>, Powers<2>, Powers<4>>{});
+        // 3 * 2 + 0 - 1.5 * 2 / 3 + 5 * 2 / 5
+        static_assert(integrate<ReferenceInterval>(poly) == 7.0);
+    }
+
+    SUBCASE("Reference square and cube")
+    {
+        constexpr auto poly2 = make_poly(
+            std::tuple(1, 4, 2), PowersList<Powers<0, 0>, Powers<2, 2>, Powers<1, 2>>{});
+        constexpr double integral = integrate<ReferenceSquare>(poly2);
+        REQUIRE(integral == doctest::Approx(4.0 + 16.0 / 9));
+
+        constexpr auto poly3 =
+            make_poly(std::array{2.0, 3.0}, PowersList<Powers<2, 0, 4>, Powers<1, 1, 1>>{});
+        REQUIRE(integrate<ReferenceCube>(poly3) == doctest::Approx(2.0 * (2.0 / 3) * 2 * (2.0 / 5)));
+    }
+
+    SUBCASE("Reference triangle and tetrahedron")
+    {
+        // Integrals of x^a y^b over the unit triangle are a! b! / (a + b + 2)!.
+        constexpr auto poly = make_poly(
+            std::array{1.0, 1.0, 1.0, 1.0},
+            PowersList<Powers<0, 0>, Powers<1, 0>, Powers<1, 1>, Powers<3, 2>>{});
+        REQUIRE(
+            integrate<ReferenceTriangle>(poly) == doctest::Approx(0.5 + 1.0 / 6 + 1.0 / 24 + 12.0 / 5040));
+
+        constexpr auto tet = make_poly(
+            std::array{6.0, 120.0}, PowersList<Powers<0, 0, 0>, Powers<1, 1, 1>>{});
+        REQUIRE(integrate<ReferenceTetrahedron>(tet) == doctest::Approx(1.0 + 1.0 / 6));
+    }
+
+    SUBCASE("Mass matrix entry from a product of shape functions")
+    {
+        // Linear Lagrange functions on the triangle: the mass matrix is (1 + delta_ij) / 24.
+        constexpr auto phi0 =
+            make_poly(std::array{1.0, -1.0, -1.0}, PowersList<Powers<0, 0>, Powers<1, 0>, Powers<0, 1>>{});
+        constexpr auto phi1 = make_poly(std::array{1.0}, PowersList<Powers<1, 0>>{});
+        REQUIRE(integrate<ReferenceTriangle>(phi0 * phi0) == doctest::Approx(1.0 / 12));
+        REQUIRE(integrate<ReferenceTriangle>(phi0 * phi1) == doctest::Approx(1.0 / 24));
+        REQUIRE(integrate<ReferenceTriangle>(phi1 * phi1) == doctest::Approx(1.0 / 12));
+    }
+
+    SUBCASE("High degree monomials stay accurate")
+    {
+        constexpr auto poly = make_poly(std::array{1.0}, PowersList<Powers<30, 30>>{});
+        // 30! 30! / 62! = 1 / (61 * 62 * C(60, 30))
+        const double expected = 1.0 / (61.0 * 62 * 118264581564861424.0);
+        REQUIRE(integrate<ReferenceTriangle>(poly) == doctest::Approx(expected));
+    }
+}
@@ -0,0 +1,55 @@
+#include "MonomialCache.hpp"
+#include "doctest.hpp"
+
+using namespace Polynomials;
+
+TEST_CASE("Monomial cache")
+{
+    constexpr auto p = make_poly(
+        std::array{1.0, -2.0, 0.5, 3.0, 1.5},
+        PowersList<Powers<0, 0, 0>, Powers<2, 1, 0>, Powers<0, 0, 3>, Powers<1, 1, 1>, Powers<3, 0, 2>>{});
+    constexpr auto q = make_poly(std::array{2.0, -1.0}, PowersList<Powers<1, 0, 0>, Powers<0, 2, 1>>{});
+
+    SUBCASE("Bound covering several polynomials")
+    {
+        static_assert(std::is_same_v<monomial_bound_t<decltype(p)>, Powers<3, 1, 3>>);
+        static_assert(std::is_same_v<monomial_bound_t<decltype(p), decltype(q)>, Powers<3, 2, 3>>);
+        using Bound = monomial_bound_t<PowersList<Powers<4, 0>>, PowersList<Powers<0, 1>>>;
+        static_assert(std::is_same_v<Bound, Powers<4, 1>>);
+        static_assert(MonomialCache<Powers<3, 2, 3>>::size == 48);
+    }
+
+    SUBCASE("Monomials")
+    {
+        constexpr auto cache = make_monomial_cache<Powers<3, 2, 3>>(2.0, 3.0, 5.0);
+        static_assert(cache[Powers<0, 0, 0>{}] == 1);
+        static_assert(cache[Powers<3, 0, 0>{}] == 8);
+        static_assert(cache[Powers<1, 2, 3>{}] == 2 * 9 * 125);
+        static_assert(cache[Powers<3, 2, 3>{}] == 8 * 9 * 125);
+    }
+
+    SUBCASE("Evaluation as a dot product")
+    {
+        using Bound = monomial_bound_t<decltype(p), decltype(q)>;
+        constexpr auto cache = make_monomial_cache<Bound>(2.0, 3.0, 5.0);
+        static_assert(cache(p) == p(2.0, 3.0, 5.0));
+        static_assert(cache(q) == q(2.0, 3.0, 5.0));
+
+        const double x = 0.3, y = -1.1, z = 0.7;
+        const auto runtime_cache = make_monomial_cache<Powers<3, 2, 3>>(x, y, z);
+        REQUIRE(runtime_cache(p) == doctest::Approx(p(x, y, z)));
+        REQUIRE(runtime_cache(q) == doctest::Approx(q(x, y, z)));
+        REQUIRE(runtime_cache(partial<0>(p)) == doctest::Approx(partial<0>(p)(x, y, z)));
+
+        const auto pq = p * q;
+        const auto product_cache = make_monomial_cache<monomial_bound_t<decltype(pq)>>(x, y, z);
+        REQUIRE(product_cache(pq) == doctest::Approx(p(x, y, z) * q(x, y, z)));
+    }
+
+    SUBCASE("Mixed precision")
+    {
+        const auto cache = make_monomial_cache<Powers<3, 2, 3>>(0.5f, 0.25f, 2.0f);
+        static_assert(std::is_same_v<decltype(cache(p)), double>);
+        REQUIRE(cache(p) == doctest::Approx(p(0.5, 0.25, 2.0)));
+    }
+}
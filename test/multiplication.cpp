@@ -62,4 +62,86 @@ TEST_CASE("Scalar multiplication test")
     {
         REQUIRE(poly3.coeffs()[i] == static_cast<int>(1.5) * poly3.coeffs()[i]);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Products of larger polynomials")
+{
+    SUBCASE("Dense total degree bases")
+    {
+        constexpr auto powers = Polynomials::total_degree_powers<3, 6>();
+        std::array<double, powers.size> coeffs{};
+        for (std::size_t i = 0; i < coeffs.size(); ++i)
+        {
+            coeffs[i] = 0.25 * (i % 9) - 1.0;
+        }
+        const auto poly = make_poly(coeffs, powers);
+        const auto poly2 = poly * poly;
+
+        constexpr auto powers2 = Polynomials::total_degree_powers<3, 12>();
+        static_assert(std::is_same_v<
+                      std::decay_t<decltype(poly2)>,
+                      std::decay_t<decltype(make_poly(std::array<double, powers2.size>{}, powers2))>>);
+        const double value = poly(0.5, -0.75, 0.25);
+        REQUIRE(poly2(0.5, -0.75, 0.25) == doctest::Approx(value * value));
+        REQUIRE(poly2(1.0, 1.0, 1.0) == doctest::Approx(poly(1.0, 1.0, 1.0) * poly(1.0, 1.0, 1.0)));
+    }
+
+    SUBCASE("Sparse, high degree polynomials")
+    {
+        constexpr auto p =
+            make_poly(std::tuple(1, 2, 3), PowersList<Powers<0, 0>, Powers<40, 0>, Powers<0, 40>>{});
+        constexpr auto q = make_poly(std::tuple(1, -1), PowersList<Powers<40, 0>, Powers<3, 37>>{});
+        constexpr auto pq = p * q;
+
+        static_assert(std::is_same_v<
+                      std::decay_t<decltype(pq)>,
+                      Polynomials::Polynomial<
+                          int, Powers<3, 37>, Powers<3, 77>, Powers<40, 0>, Powers<40, 40>, Powers<43, 37>,
+                          Powers<80, 0>>>);
+        REQUIRE(pq.coeffs() == std::array{-1, -3, 1, 3, -2, 2});
+    }
+
+    SUBCASE("Product exponents too large to encode in 64 bits")
+    {
+        // Exponents up to 400 in 8 variables give 401^8 keys, so terms are compared as arrays.
+        using X = Powers<200, 0, 0, 0, 0, 0, 0, 0>;
+        using YZ = Powers<0, 200, 200, 200, 200, 200, 200, 200>;
+        using One = Powers<0, 0, 0, 0, 0, 0, 0, 0>;
+        constexpr auto p = make_poly(std::tuple(1.0, 2.0, 3.0), PowersList<X, YZ, One>{});
+        constexpr auto pp = p * p;
+        static_assert(pp.num_terms == 6);
+        REQUIRE(pp.coeffs() == std::array{9.0, 12.0, 4.0, 6.0, 4.0, 1.0});
+        REQUIRE(pp(1.001, 0.999, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0) ==
+                doctest::Approx(p(1.001, 0.999, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0) *
+                                p(1.001, 0.999, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0)));
+    }
+}
+
+TEST_CASE("Fused multiply-accumulate into a polynomial with a superset of the terms")
+{
+    using Polynomials::fma_into;
+    constexpr auto basis = Polynomials::total_degree_powers<2, 1>();
+    constexpr auto p = make_poly(std::array{1.0, -2.0, 0.5}, basis);
+    constexpr auto q = make_poly(std::array{3.0, 1.0}, PowersList<Powers<0, 1>, Powers<1, 0>>{});
+
+    auto acc = make_poly(
+        std::array<double, 10>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, Polynomials::total_degree_powers<2, 3>());
+    const auto before = acc;
+    fma_into(acc, 0.25, p, q);
+    fma_into(acc, -1.0, q, q);
+
+    const auto expected = before + p * q * 0.25 + q * q * -1.0;
+    static_assert(expected.num_terms == 10);
+    for (std::size_t i = 0; i < acc.num_terms; ++i)
+    {
+        REQUIRE(acc.coeffs()[i] == doctest::Approx(expected.coeffs()[i]));
+    }
+
+    constexpr auto at_compile_time = []() {
+        auto sum = make_poly(std::array{0, 0, 0}, PowersList<Powers<0>, Powers<1>, Powers<2>>{});
+        const auto linear = make_poly(std::array{1, 2}, PowersList<Powers<0>, Powers<1>>{});
+        return fma_into(sum, 3, linear, linear);
+    }();
+    static_assert(at_compile_time.coeffs()[0] == 3);
+    static_assert(at_compile_time.coeffs()[1] == 12 && at_compile_time.coeffs()[2] == 12);
+}
@@ -0,0 +1,52 @@
+#include "Parallel.hpp"
+#include "doctest.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace Polynomials;
+
+TEST_CASE("ThreadPool runs every task exactly once")
+{
+    for (std::size_t nthreads : {1, 2, 5})
+    {
+        ThreadPool pool(nthreads);
+        REQUIRE(pool.size() == nthreads);
+        for (std::size_t ntasks : {0, 1, 3, 100})
+        {
+            std::vector<std::atomic<int>> counts(ntasks);
+            for (int repeat = 0; repeat < 3; ++repeat)
+            {
+                pool.parallel_for(ntasks, [&](std::size_t i) { counts[i].fetch_add(1); });
+            }
+            for (auto &count : counts)
+            {
+                REQUIRE(count.load() == 3);
+            }
+        }
+    }
+}
+
+TEST_CASE("Parallel batch evaluation matches serial batch evaluation")
+{
+    constexpr auto powers = total_degree_powers<2, 4>();
+    std::array<double, powers.size> coeffs{0};
+    for (std::size_t i = 0; i < coeffs.size(); ++i)
+    {
+        coeffs[i] = 1.0 / (i + 1);
+    }
+    const auto poly = make_poly(coeffs, powers);
+
+    const std::size_t n = 5 * detail::parallel_chunk_size + 123;
+    std::vector<double> xs(n), ys(n), serial(n), parallel(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        xs[i] = -1.0 + 2.0 * i / n;
+        ys[i] = 0.5 * xs[i] * xs[i];
+    }
+    evaluate_batch(poly, serial.data(), n, xs.data(), ys.data());
+
+    ThreadPool pool(3);
+    parallel_evaluate_batch(pool, poly, parallel.data(), n, xs.data(), ys.data());
+    REQUIRE(parallel == serial);
+}
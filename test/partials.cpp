@@ -46,4 +46,69 @@ TEST_CASE("Partial derivatives for a function of two variables")
     REQUIRE(d1poly.coeffs()[2] == 1);
     REQUIRE(d1poly.coeffs()[3] == 4);
     REQUIRE(d1poly.coeffs()[4] == 2);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Fused value and gradient evaluation")
+{
+    constexpr auto powers = PowersList<
+        Powers<0, 0>, Powers<0, 1>, Powers<0, 2>, Powers<1, 0>, Powers<1, 1>, Powers<1, 2>, Powers<2, 2>>{};
+    constexpr int coefficients[] = {1, 2, 1, 2, -1, 2, 1};
+    constexpr auto poly = make_poly(coefficients, powers);
+
+    SUBCASE("Value and gradient agree with operator() and partial<I>()")
+    {
+        constexpr auto dpoly = poly * 1.0;
+        std::array<double, 3> out{};
+        dpoly.value_and_gradient(out, 1.5, -2.0);
+        REQUIRE(out[0] == doctest::Approx(dpoly(1.5, -2.0)));
+        REQUIRE(out[1] == doctest::Approx(partial<0>(dpoly)(1.5, -2.0)));
+        REQUIRE(out[2] == doctest::Approx(partial<1>(dpoly)(1.5, -2.0)));
+    }
+
+    SUBCASE("Usable in a constant expression")
+    {
+        constexpr auto out = [=]() {
+            std::array<int, 3> result{};
+            poly.value_and_gradient(result, 2, 3);
+            return result;
+        }();
+        static_assert(out[0] == poly(2, 3));
+        // d/dx = 2 - y + 2y^2 + 2xy^2, d/dy = 2 + 2y - x + 4xy + 2x^2 y
+        static_assert(out[1] == 2 - 3 + 18 + 36);
+        static_assert(out[2] == 2 + 6 - 2 + 24 + 24);
+    }
+
+    SUBCASE("Hessian")
+    {
+        constexpr auto dpoly = poly * 1.0;
+        double out[7] = {};
+        dpoly.value_gradient_hessian(out, 1.5, -2.0);
+        const double x = 1.5, y = -2.0;
+        REQUIRE(out[0] == doctest::Approx(dpoly(x, y)));
+        REQUIRE(out[1] == doctest::Approx(partial<0>(dpoly)(x, y)));
+        REQUIRE(out[2] == doctest::Approx(partial<1>(dpoly)(x, y)));
+        REQUIRE(out[3] == doctest::Approx(2 * y * y));
+        REQUIRE(out[4] == doctest::Approx(-1 + 4 * y + 4 * x * y));
+        REQUIRE(out[5] == out[4]);
+        REQUIRE(out[6] == doctest::Approx(2 + 4 * x + 2 * x * x));
+    }
+
+    SUBCASE("Variable absent from every term")
+    {
+        constexpr auto p = make_poly(std::array{3.0, 2.0}, PowersList<Powers<0, 0>, Powers<2, 0>>{});
+        double out[3] = {-1, -1, -1};
+        p.value_and_gradient(out, 2.0, 5.0);
+        REQUIRE(out[0] == 11.0);
+        REQUIRE(out[1] == 8.0);
+        REQUIRE(out[2] == 0.0);
+    }
+}
+
+TEST_CASE("Partial derivative with respect to a variable that does not appear")
+{
+    constexpr auto poly = make_poly(std::array{1.5, 2.0}, PowersList<Powers<0, 0>, Powers<0, 3>>{});
+    constexpr auto d0 = partial<0>(poly);
+    static_assert(d0.num_terms == 1);
+    static_assert(d0(2.0, 3.0) == 0.0);
+    static_assert(partial<1>(poly)(2.0, 3.0) == 54.0);
+}
@@ -0,0 +1,205 @@
+#include "PolynomialBatch.hpp"
+#include "doctest.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace Polynomials;
+
+namespace
+{
+
+constexpr auto powers = PowersList<Powers<0, 0>, Powers<1, 0>, Powers<0, 1>, Powers<2, 1>, Powers<1, 2>>{};
+
+template <class Batch>
+void fill_batch(Batch &batch)
+{
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const auto p = make_poly(std::array{1.0 * i, 0.5, -0.25 * i, 1.0 + i, 2.0 - i}, powers);
+        batch.set(i, p);
+    }
+}
+
+} // namespace
+
+TEST_CASE("PolynomialBatch layout and element access")
+{
+    auto batch = make_poly_batch<double>(powers, 13);
+    fill_batch(batch);
+
+    REQUIRE(batch.size() == 13);
+    REQUIRE(batch.stride() >= 13);
+    REQUIRE(batch.stride() % simd::native_width_v<double> == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(batch.coeffs(0)) % 64 == 0);
+
+    const auto p = batch[5];
+    const auto expected = make_poly(std::array{5.0, 0.5, -1.25, 6.0, -3.0}, powers);
+    for (std::size_t j = 0; j < p.num_terms; ++j)
+    {
+        REQUIRE(p.coeffs()[j] == expected.coeffs()[j]);
+        REQUIRE(batch.coeffs(j)[5] == expected.coeffs()[j]);
+    }
+}
+
+TEST_CASE("PolynomialBatch arithmetic")
+{
+    auto batch = make_poly_batch<double>(powers, 11);
+    fill_batch(batch);
+
+    const auto sum = batch + batch * 2.0;
+    auto scaled = batch;
+    scaled *= 3;
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const auto expected = batch[i] * 3.0;
+        for (std::size_t j = 0; j < batch.num_terms; ++j)
+        {
+            REQUIRE(sum[i].coeffs()[j] == expected.coeffs()[j]);
+            REQUIRE(scaled[i].coeffs()[j] == expected.coeffs()[j]);
+        }
+    }
+
+    const auto d1 = batch.partial<1>();
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const auto expected = partial<1>(batch[i]);
+        static_assert(std::is_same_v<
+            std::decay_t<decltype(d1[i])>, std::decay_t<decltype(expected)>>);
+        for (std::size_t j = 0; j < expected.num_terms; ++j)
+        {
+            REQUIRE(d1[i].coeffs()[j] == expected.coeffs()[j]);
+        }
+    }
+
+    // No term depends on y, so every derivative is the zero constant.
+    auto in_x = make_poly_batch<double>(PowersList<Powers<0, 0>, Powers<2, 0>>{}, 5);
+    in_x.set(2, make_poly(std::array{1.0, 3.0}, PowersList<Powers<0, 0>, Powers<2, 0>>{}));
+    const auto dy = in_x.partial<1>();
+    static_assert(std::is_same_v<std::decay_t<decltype(dy)>, PolynomialBatch<double, Powers<0, 0>>>);
+    REQUIRE(dy.size() == 5);
+    for (std::size_t i = 0; i < dy.size(); ++i)
+    {
+        REQUIRE(dy[i].coeffs()[0] == 0.0);
+    }
+}
+
+TEST_CASE("Scaling a PolynomialBatch promotes like Polynomial")
+{
+    auto batch = make_poly_batch<int>(powers, 9);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const int c = static_cast<int>(i);
+        batch.set(i, make_poly(std::array{c, 1, -c, 2 * c + 1, 3}, powers));
+    }
+
+    const auto halved = batch * 0.5;
+    static_assert(
+        std::is_same_v<std::decay_t<decltype(halved)>, decltype(make_poly_batch<double>(powers, 0))>);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const auto expected = batch[i] * 0.5;
+        for (std::size_t j = 0; j < batch.num_terms; ++j)
+        {
+            REQUIRE(halved[i].coeffs()[j] == expected.coeffs()[j]);
+        }
+    }
+
+    auto tripled = batch;
+    tripled *= 3;
+    auto scaled = batch;
+    scaled *= 1.5;
+    static_assert(std::is_same_v<decltype(batch * 3), decltype(batch)>);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        auto expected = batch[i];
+        expected *= 1.5;
+        for (std::size_t j = 0; j < batch.num_terms; ++j)
+        {
+            REQUIRE(tripled[i].coeffs()[j] == 3 * batch[i].coeffs()[j]);
+            REQUIRE(scaled[i].coeffs()[j] == expected.coeffs()[j]);
+        }
+    }
+}
+
+TEST_CASE("PolynomialBatch evaluation")
+{
+    auto batch = make_poly_batch<double>(powers, 21);
+    fill_batch(batch);
+    std::vector<double> out(batch.size());
+
+    SUBCASE("All polynomials at one point")
+    {
+        batch.evaluate(out.data(), 1.5, -0.75);
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            REQUIRE(out[i] == doctest::Approx(batch[i](1.5, -0.75)));
+        }
+    }
+
+    SUBCASE("Each polynomial at its own point")
+    {
+        std::vector<double> xs(batch.size()), ys(batch.size());
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            xs[i] = 0.1 * i;
+            ys[i] = 1.0 - 0.05 * i;
+        }
+        batch.evaluate_each(out.data(), xs.data(), ys.data());
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            REQUIRE(out[i] == doctest::Approx(batch[i](xs[i], ys[i])));
+        }
+    }
+}
+
+TEST_CASE("Evaluating a batch at a set of reference points")
+{
+    SUBCASE("Small batch")
+    {
+        auto batch = make_poly_batch<double>(powers, 7);
+        fill_batch(batch);
+        const double xs[] = {0.0, 0.5, -1.0};
+        const double ys[] = {1.0, -0.25, 2.0};
+        double out[7 * 3];
+        evaluate_at_points(batch, out, 3, xs, ys);
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            for (std::size_t q = 0; q < 3; ++q)
+            {
+                REQUIRE(out[i * 3 + q] == doctest::Approx(batch[i](xs[q], ys[q])));
+            }
+        }
+    }
+
+    SUBCASE("More terms and points than one cache block")
+    {
+        constexpr auto dense = total_degree_powers<2, 22>();
+        static_assert(dense.size > detail::gemm_kc);
+        auto batch = make_poly_batch<double>(dense, 9);
+        for (std::size_t j = 0; j < batch.num_terms; ++j)
+        {
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                batch.coeffs(j)[i] = 1.0 / (1 + j + i);
+            }
+        }
+
+        constexpr std::size_t n = detail::gemm_nc + 37;
+        std::vector<double> xs(n), ys(n), out(batch.size() * n);
+        for (std::size_t q = 0; q < n; ++q)
+        {
+            xs[q] = -1.0 + 2.0 * q / n;
+            ys[q] = 0.5 - 1.0 * q / n;
+        }
+        evaluate_at_points(batch, out.data(), n, xs.data(), ys.data());
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            const auto p = batch[i];
+            for (std::size_t q = 0; q < n; q += 13)
+            {
+                REQUIRE(out[i * n + q] == doctest::Approx(p(xs[q], ys[q])));
+            }
+        }
+    }
+}
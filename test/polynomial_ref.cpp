@@ -0,0 +1,95 @@
+#include "PolynomialBatch.hpp"
+#include "PolynomialRef.hpp"
+#include "doctest.hpp"
+
+#include <vector>
+
+using namespace Polynomials;
+
+namespace
+{
+
+using PL = PowersList<Powers<0, 0>, Powers<0, 2>, Powers<1, 0>, Powers<2, 1>>;
+
+} // namespace
+
+TEST_CASE("PolynomialRef views external coefficients")
+{
+    const auto p = make_poly(std::array{1.0, -2.0, 0.5, 3.0}, PL{});
+
+    SUBCASE("Contiguous and strided storage")
+    {
+        std::vector<double> contiguous(p.coeffs().begin(), p.coeffs().end());
+        const auto ref = make_poly_ref(contiguous.data(), PL{});
+        REQUIRE(ref(0.3, -0.7) == doctest::Approx(p(0.3, -0.7)));
+        REQUIRE(ref(2.0, 1.5) == doctest::Approx(p(2.0, 1.5)));
+
+        std::vector<double> strided(3 * PL::size, 99.0);
+        for (std::size_t j = 0; j < PL::size; ++j)
+        {
+            strided[3 * j] = p.coeffs()[j];
+        }
+        const auto sref = make_poly_ref(static_cast<const double *>(strided.data()), PL{}, 3);
+        REQUIRE(sref(0.3, -0.7) == doctest::Approx(p(0.3, -0.7)));
+        REQUIRE(sref.to_poly().coeffs() == p.coeffs());
+    }
+
+    SUBCASE("Compile-time evaluation")
+    {
+        static constexpr std::array<int, 4> cs{1, 2, 3, 4};
+        constexpr auto ref = make_poly_ref(cs.data(), PL{});
+        static_assert(ref(1, 2) == 1 + 2 * 4 + 3 + 4 * 2);
+    }
+
+    SUBCASE("Partial derivatives, materialized and lazy")
+    {
+        std::array<double, 4> cs = p.coeffs();
+        const auto ref = make_poly_ref(cs.data(), PL{});
+        const auto dx = partial<0>(ref);
+        static_assert(std::is_same_v<std::decay_t<decltype(dx)>, std::decay_t<decltype(partial<0>(p))>>);
+        REQUIRE(dx.coeffs() == partial<0>(p).coeffs());
+
+        const auto lazy_dy = ref.lazy_partial<1>();
+        REQUIRE(lazy_dy(0.3, -0.7) == doctest::Approx(partial<1>(p)(0.3, -0.7)));
+
+        // The lazy derivative reads the coefficients when evaluated.
+        cs[1] = 4.0;
+        REQUIRE(lazy_dy(0.3, -0.7) == doctest::Approx(partial<1>(ref.to_poly())(0.3, -0.7)));
+
+        const auto constant = make_poly(std::array{2.0, 1.0}, PowersList<Powers<0, 0>, Powers<1, 0>>{});
+        std::array<double, 2> ccs = constant.coeffs();
+        const auto cref = make_poly_ref(ccs.data(), PowersList<Powers<0, 0>, Powers<1, 0>>{});
+        REQUIRE(cref.lazy_partial<1>()(0.5, 0.5) == 0.0);
+        REQUIRE(partial<1>(cref)(0.5, 0.5) == 0.0);
+    }
+
+    SUBCASE("In-place updates")
+    {
+        std::vector<double> storage(2 * PL::size, 0.0);
+        const auto ref = make_poly_ref(storage.data() + 1, PL{}, 2);
+        ref += p;
+        ref += p;
+        ref *= 0.25;
+        for (std::size_t j = 0; j < PL::size; ++j)
+        {
+            REQUIRE(storage[2 * j] == 0.0);
+            REQUIRE(storage[2 * j + 1] == doctest::Approx(0.5 * p.coeffs()[j]));
+        }
+
+        const PolynomialRef<const double, Powers<0, 0>, Powers<0, 2>, Powers<1, 0>, Powers<2, 1>> view =
+            ref;
+        const std::array<double, 4> ones{1, 1, 1, 1};
+        ref += make_poly_ref(ones.data(), PL{});
+        REQUIRE(view[0] == doctest::Approx(0.5 * p.coeffs()[0] + 1));
+    }
+
+    SUBCASE("Viewing a polynomial of a batch")
+    {
+        auto batch = make_poly_batch<double>(PL{}, 5);
+        batch.set(3, p);
+        const auto ref = make_poly_ref(batch.coeffs(0) + 3, PL{}, batch.stride());
+        REQUIRE(ref(0.3, -0.7) == doctest::Approx(p(0.3, -0.7)));
+        ref *= 2;
+        REQUIRE(batch[3](0.3, -0.7) == doctest::Approx(2 * p(0.3, -0.7)));
+    }
+}
@@ -0,0 +1,139 @@
+#include "Polynomial.hpp"
+#include "Simd.hpp"
+#include "doctest.hpp"
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define POLYNOMIALS_HAVE_EXPERIMENTAL_SIMD
+#endif
+
+using namespace Polynomials;
+
+namespace
+{
+
+// A minimal homegrown lane-vector type, standing in for user SIMD wrappers.
+struct Vec4d
+{
+    double lanes[4];
+
+    Vec4d() noexcept : lanes{0, 0, 0, 0} {}
+    Vec4d(double x) noexcept : lanes{x, x, x, x} {}
+    Vec4d(double a, double b, double c, double d) noexcept : lanes{a, b, c, d} {}
+
+    friend Vec4d operator+(const Vec4d &a, const Vec4d &b) noexcept
+    {
+        return Vec4d(a.lanes[0] + b.lanes[0], a.lanes[1] + b.lanes[1], a.lanes[2] + b.lanes[2],
+                     a.lanes[3] + b.lanes[3]);
+    }
+
+    friend Vec4d operator*(const Vec4d &a, const Vec4d &b) noexcept
+    {
+        return Vec4d(a.lanes[0] * b.lanes[0], a.lanes[1] * b.lanes[1], a.lanes[2] * b.lanes[2],
+                     a.lanes[3] * b.lanes[3]);
+    }
+
+    double operator[](std::size_t i) const noexcept { return lanes[i]; }
+};
+
+constexpr auto powers = PowersList<Powers<3, 0>, Powers<0, 3>, Powers<2, 1>, Powers<1, 2>,
+    Powers<2, 0>, Powers<0, 2>, Powers<1, 1>, Powers<1, 0>, Powers<0, 1>, Powers<0, 0>>{};
+constexpr std::array<double, powers.size> coeffs{2, 1, -3, 4, 0.5, 5, 1, 1, 2, 1};
+constexpr double xs[] = {1.0, 2.0, -0.5, 0.25};
+constexpr double ys[] = {2.0, 2.0, 1.5, -3.0};
+
+template <class V>
+void check_lane_evaluation()
+{
+    constexpr auto poly = make_poly(coeffs, powers);
+    const V x(xs[0], xs[1], xs[2], xs[3]);
+    const V y(ys[0], ys[1], ys[2], ys[3]);
+
+    const auto value = poly(x, y);
+    static_assert(std::is_same_v<std::decay_t<decltype(value)>, V>);
+    const auto horner = poly.evaluate(Horner<>{}, x, y);
+    const auto table = poly.evaluate(PowerTable{}, x, y);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        REQUIRE(value[i] == doctest::Approx(poly(xs[i], ys[i])));
+        REQUIRE(horner[i] == doctest::Approx(poly(xs[i], ys[i])));
+        REQUIRE(table[i] == doctest::Approx(poly(xs[i], ys[i])));
+    }
+}
+
+template <class V>
+void check_lane_coefficients()
+{
+    // Four scalar polynomials packed lane-wise into one polynomial with vector coefficients.
+    const auto vpoly = make_poly(
+        std::array<V, 3>{V(1, 2, 3, 4), V(0.5, -1, 2, 0), V(1, 1, -1, 3)},
+        PowersList<Powers<0>, Powers<1>, Powers<2>>{});
+    static_assert(std::is_same_v<typename std::decay_t<decltype(vpoly.coeffs())>::value_type, V>);
+
+    const auto scaled = vpoly * 2.0;
+    const auto dpoly = partial<0>(vpoly);
+    const auto squared = vpoly * vpoly;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        const auto lane = make_poly(
+            std::array{vpoly.coeffs()[0][i], vpoly.coeffs()[1][i], vpoly.coeffs()[2][i]},
+            PowersList<Powers<0>, Powers<1>, Powers<2>>{});
+        REQUIRE(vpoly(1.5)[i] == doctest::Approx(lane(1.5)));
+        REQUIRE(scaled(1.5)[i] == doctest::Approx(2 * lane(1.5)));
+        REQUIRE(dpoly(1.5)[i] == doctest::Approx(partial<0>(lane)(1.5)));
+        REQUIRE(squared(-0.5)[i] == doctest::Approx((lane * lane)(-0.5)));
+    }
+}
+
+} // namespace
+
+TEST_CASE("Numeric type trait")
+{
+    static_assert(is_numeric_v<double>);
+    static_assert(is_numeric_v<char>);
+    static_assert(is_numeric_v<Vec4d>);
+    static_assert(is_numeric_v<simd::Vec<double, 4>>);
+    static_assert(is_numeric_v<simd::native_vec<float>>);
+    static_assert(!is_numeric_v<std::array<double, 4>>);
+    static_assert(!is_numeric_v<decltype(make_poly(coeffs, powers))>);
+}
+
+TEST_CASE("Evaluating at lane-vector arguments")
+{
+    check_lane_evaluation<Vec4d>();
+}
+
+TEST_CASE("Polynomials with lane-vector coefficients")
+{
+    check_lane_coefficients<Vec4d>();
+}
+
+TEST_CASE("Library SIMD vector type")
+{
+    constexpr auto poly = make_poly(coeffs, powers);
+    using V = simd::Vec<double, 4>;
+    alignas(32) const double xa[] = {xs[0], xs[1], xs[2], xs[3]};
+    alignas(32) const double ya[] = {ys[0], ys[1], ys[2], ys[3]};
+    const auto value = poly(V::load(xa), V::load(ya));
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        REQUIRE(value[i] == doctest::Approx(poly(xs[i], ys[i])));
+    }
+}
+
+#ifdef POLYNOMIALS_HAVE_EXPERIMENTAL_SIMD
+TEST_CASE("std::experimental::simd arguments")
+{
+    namespace stdx = std::experimental;
+    using V = stdx::fixed_size_simd<double, 4>;
+    constexpr auto poly = make_poly(coeffs, powers);
+
+    const V x([](auto i) { return xs[i]; });
+    const V y([](auto i) { return ys[i]; });
+    const V value = poly(x, y);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        REQUIRE(value[i] == doctest::Approx(poly(xs[i], ys[i])));
+    }
+}
+#endif
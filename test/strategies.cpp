@@ -0,0 +1,268 @@
+#include "Polynomial.hpp"
+#include "doctest.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Polynomials;
+
+namespace
+{
+
+template <class... Ps>
+constexpr auto make_test_coeffs(PowersList<Ps...>) noexcept
+{
+    std::array<double, sizeof...(Ps)> coeffs{0};
+    for (std::size_t i = 0; i < coeffs.size(); ++i)
+    {
+        coeffs[i] = 0.5 + 0.25 * (i % 7) - 0.125 * (i % 3);
+    }
+    return coeffs;
+}
+
+} // namespace
+
+TEST_CASE("Horner evaluation matches naive evaluation")
+{
+    SUBCASE("Single variable with gaps in the exponents")
+    {
+        constexpr auto powers = PowersList<Powers<2>, Powers<5>, Powers<6>, Powers<11>>{};
+        constexpr auto poly = make_poly(std::array{1.0, -2.0, 0.5, 3.0}, powers);
+        constexpr double x = 1.25;
+        REQUIRE(poly.evaluate(Horner<>{}, x) == doctest::Approx(poly(x)));
+        static_assert(poly.evaluate(Horner<>{}, 2.0) == poly(2.0));
+    }
+
+    SUBCASE("Multivariable polynomial, every variable ordering")
+    {
+        constexpr auto powers = PowersList<Powers<3, 0>, Powers<0, 3>, Powers<2, 1>, Powers<1, 2>,
+            Powers<2, 0>, Powers<0, 2>, Powers<1, 1>, Powers<1, 0>, Powers<0, 1>, Powers<0, 0>>{};
+        constexpr std::array<int, powers.size> coeffs{2, 1, -3, 4, 0, 5, 1, 1, 2, 1};
+        constexpr auto poly = make_poly(coeffs, powers);
+
+        static_assert(poly.evaluate(Horner<>{}, 1, 2) == 48);
+        static_assert(poly.evaluate(Horner<1, 0>{}, 2, 2) == 63);
+        REQUIRE(poly.evaluate(Horner<0, 1>{}, 4.0, '\2') == 141);
+        REQUIRE(poly.evaluate(Naive{}, 4.0, '\2') == 141);
+    }
+
+    SUBCASE("Dense three-variable polynomial")
+    {
+        constexpr auto powers = total_degree_powers<3, 6>();
+        const auto poly = make_poly(make_test_coeffs(powers), powers);
+        const double x = 0.75, y = -1.25, z = 0.5;
+        const double expected = poly(x, y, z);
+        REQUIRE(poly.evaluate(Horner<>{}, x, y, z) == doctest::Approx(expected));
+        REQUIRE(poly.evaluate(Horner<2, 0, 1>{}, x, y, z) == doctest::Approx(expected));
+        REQUIRE(poly.evaluate(Horner<1, 2, 0>{}, x, y, z) == doctest::Approx(expected));
+    }
+}
+
+TEST_CASE("Operation counts for Horner evaluation")
+{
+    SUBCASE("Dense univariate polynomial uses one multiply and add per degree")
+    {
+        constexpr auto powers = total_degree_powers<1, 8>();
+        constexpr auto horner = detail::horner_op_count(powers);
+        static_assert(horner.multiplications == 8);
+        static_assert(horner.additions == 8);
+        static_assert(detail::naive_op_count(powers).multiplications == 37);
+    }
+
+    SUBCASE("Total degree 6 in 3 variables")
+    {
+        constexpr auto powers = total_degree_powers<3, 6>();
+        static_assert(powers.size == 84);
+        constexpr auto naive = detail::naive_op_count(powers);
+        constexpr auto horner = detail::horner_op_count(powers);
+        static_assert(naive.multiplications == 462);
+        static_assert(horner.multiplications == 83);
+        static_assert(horner.additions == naive.additions);
+        static_assert(detail::horner_op_count<2, 1, 0>(powers).multiplications == 83);
+    }
+}
+
+TEST_CASE("Power table evaluation")
+{
+    SUBCASE("Matches naive evaluation")
+    {
+        constexpr auto powers = PowersList<Powers<3, 0>, Powers<0, 3>, Powers<2, 1>, Powers<1, 2>,
+            Powers<2, 0>, Powers<0, 2>, Powers<1, 1>, Powers<1, 0>, Powers<0, 1>, Powers<0, 0>>{};
+        constexpr std::array<int, powers.size> coeffs{2, 1, -3, 4, 0, 5, 1, 1, 2, 1};
+        constexpr auto poly = make_poly(coeffs, powers);
+
+        static_assert(poly.evaluate(PowerTable{}, 1, 2) == 48);
+        static_assert(poly.evaluate(PowerTable{}, 2, 2) == 63);
+        REQUIRE(poly.evaluate(PowerTable{}, 4.0, '\2') == 141);
+
+        constexpr auto dense = total_degree_powers<3, 6>();
+        const auto poly2 = make_poly(make_test_coeffs(dense), dense);
+        REQUIRE(poly2.evaluate(PowerTable{}, 0.75, -1.25, 0.5) == doctest::Approx(poly2(0.75, -1.25, 0.5)));
+    }
+
+    SUBCASE("Variable that does not appear in any term")
+    {
+        constexpr auto powers = PowersList<Powers<0, 0, 2>, Powers<3, 0, 1>>{};
+        constexpr auto poly = make_poly(std::array{1.5, -2.0}, powers);
+        REQUIRE(poly.evaluate(PowerTable{}, 2.0, 7.0, 3.0) == doctest::Approx(poly(2.0, 7.0, 3.0)));
+    }
+
+    SUBCASE("Operation counts")
+    {
+        constexpr auto powers = total_degree_powers<3, 6>();
+        constexpr auto table = detail::power_table_op_count(powers);
+        // 5 multiplications per ladder, and one per non-zero exponent in each term.
+        static_assert(table.multiplications == 15 + 168);
+        static_assert(table.multiplications < detail::naive_op_count(powers).multiplications);
+        static_assert(table.additions == 83);
+    }
+}
+
+TEST_CASE("Estrin evaluation")
+{
+    SUBCASE("Dense univariate polynomials are exact for integers")
+    {
+        constexpr auto powers = total_degree_powers<1, 8>();
+        constexpr auto poly = make_poly(std::array{3, -1, 4, 1, -5, 9, 2, -6, 5}, powers);
+        static_assert(poly.evaluate(Estrin<>{}, 2) == poly(2));
+        static_assert(poly.evaluate(Estrin<>{}, -3) == poly(-3));
+
+        constexpr auto powers13 = total_degree_powers<1, 13>();
+        constexpr auto poly13 = make_poly(make_test_coeffs(powers13), powers13);
+        REQUIRE(poly13.evaluate(Estrin<>{}, 0.875) == doctest::Approx(poly13(0.875)));
+    }
+
+    SUBCASE("Single variable with gaps in the exponents")
+    {
+        constexpr auto powers = PowersList<Powers<2>, Powers<5>, Powers<6>, Powers<11>>{};
+        constexpr auto poly = make_poly(std::array{1, -2, 3, 4}, powers);
+        static_assert(poly.evaluate(Estrin<>{}, 2) == poly(2));
+        static_assert(poly.evaluate(Estrin<>{}, -1) == poly(-1));
+    }
+
+    SUBCASE("Several variables, in any order")
+    {
+        constexpr auto powers = total_degree_powers<3, 6>();
+        const auto poly = make_poly(make_test_coeffs(powers), powers);
+        const double x = 0.75, y = -1.25, z = 0.5;
+        const double expected = poly(x, y, z);
+        REQUIRE(poly.evaluate(Estrin<>{}, x, y, z) == doctest::Approx(expected));
+        REQUIRE(poly.evaluate(Estrin<2, 0, 1>{}, x, y, z) == doctest::Approx(expected));
+
+        constexpr auto sparse = PowersList<Powers<0, 0, 2>, Powers<3, 0, 1>, Powers<7, 2, 0>>{};
+        constexpr auto poly2 = make_poly(std::array{1, -2, 3}, sparse);
+        static_assert(poly2.evaluate(Estrin<>{}, 2, 3, -1) == poly2(2, 3, -1));
+    }
+
+    SUBCASE("Operation counts")
+    {
+        // One multiplication and addition per split, plus the squarings x^2, x^4, ...
+        static_assert(op_count(Estrin<>{}, total_degree_powers<1, 8>()).multiplications == 8 + 3);
+        static_assert(op_count(Estrin<>{}, total_degree_powers<1, 8>()).additions == 8);
+        static_assert(op_count(Estrin<>{}, total_degree_powers<1, 32>()).multiplications == 32 + 5);
+        static_assert(op_count(Estrin<>{}, total_degree_powers<1, 32>()).additions == 32);
+        static_assert(
+            op_count(Estrin<>{}, total_degree_powers<3, 6>()).additions ==
+            op_count(Horner<>{}, total_degree_powers<3, 6>()).additions);
+    }
+}
+
+TEST_CASE("Static cost model")
+{
+    using PL = PowersList<Powers<3, 0, 1>, Powers<0, 2, 0>, Powers<1, 1, 4>, Powers<0, 0, 0>>;
+    constexpr auto maxes = PL::max_degrees();
+    static_assert(maxes[0] == 3 && maxes[1] == 2 && maxes[2] == 4);
+    static_assert(PL::total_degree() == 6);
+
+    constexpr auto dense = total_degree_powers<3, 6>();
+    constexpr auto poly = make_poly(make_test_coeffs(dense), dense);
+    using Poly = std::decay_t<decltype(poly)>;
+    static_assert(Poly::total_degree() == 6);
+    static_assert(poly.max_degrees()[0] == 6 && poly.max_degrees()[1] == 6 && poly.max_degrees()[2] == 6);
+
+    static_assert(Poly::cost(Naive{}).multiplications == 462);
+    static_assert(Poly::cost<Horner<>>().multiplications == 83);
+    static_assert(poly.cost(Horner<2, 1, 0>{}).multiplications == 83);
+    static_assert(Poly::cost(PowerTable{}).multiplications == 15 + 168);
+    static_assert(Poly::cost(Accumulate<double, PowerTable>{}).multiplications == 15 + 168);
+    static_assert(Poly::cost(Accumulate<double>{}).multiplications == 83);
+    static_assert(decltype(dense)::cost(Horner<>{}).additions == 83);
+
+    constexpr auto cheapest = [](auto p) {
+        using P = decltype(p);
+        if constexpr (P::cost(Horner<>{}).multiplications <= P::cost(PowerTable{}).multiplications)
+        {
+            return p.evaluate(Horner<>{}, 0.5, -0.25, 2.0);
+        }
+        else
+        {
+            return p.evaluate(PowerTable{}, 0.5, -0.25, 2.0);
+        }
+    };
+    REQUIRE(cheapest(poly) == doctest::Approx(poly(0.5, -0.25, 2.0)));
+}
+
+TEST_CASE("Mixed precision and compensated evaluation")
+{
+    // (x - 3/4)^5 expanded; every coefficient is exact in float.
+    constexpr auto powers = PowersList<Powers<5>, Powers<4>, Powers<3>, Powers<2>, Powers<1>, Powers<0>>{};
+    constexpr auto poly = make_poly(
+        std::array<float, 6>{1.0f, -3.75f, 5.625f, -4.21875f, 1.58203125f, -0.2373046875f}, powers);
+
+    SUBCASE("Accumulate in a wider type")
+    {
+        static_assert(std::is_same_v<decltype(poly.evaluate(Accumulate<double>{}, 1.0f)), double>);
+        static_assert(poly.evaluate(Accumulate<double>{}, 1.75f) == 1.0);
+        static_assert(poly.evaluate(Accumulate<double, Naive>{}, 1.75f) == 1.0);
+        static_assert(poly.evaluate(Accumulate<double, PowerTable>{}, 1.75f) == 1.0);
+    }
+
+    SUBCASE("Compensated Horner near a multiple root")
+    {
+        static_assert(std::is_same_v<decltype(poly.evaluate(CompensatedHorner<float>{}, 1.0f)), float>);
+        static_assert(
+            std::is_same_v<decltype(poly.evaluate(CompensatedHorner<float, double>{}, 1.0f)), double>);
+
+        double horner_error = 0, compensated_error = 0;
+        for (int i = 5; i <= 50; ++i)
+        {
+            const float x = 0.75f + i * 1.0e-2f;
+            const long double exact = std::pow(static_cast<long double>(x) - 0.75L, 5);
+            const double scale = static_cast<double>(std::fabs(exact));
+            horner_error = std::max(
+                horner_error, std::fabs(static_cast<double>(poly.evaluate(Horner<>{}, x) - exact)) / scale);
+            const double compensated = poly.evaluate(CompensatedHorner<float, double>{}, x);
+            compensated_error =
+                std::max(compensated_error, std::fabs(static_cast<double>(compensated - exact)) / scale);
+        }
+        REQUIRE(horner_error > 1.0e-2);
+        REQUIRE(compensated_error < 1.0e-5);
+        REQUIRE(compensated_error * 1000 < horner_error);
+    }
+
+    SUBCASE("Compensated evaluation of a multivariate polynomial")
+    {
+        constexpr auto dense = total_degree_powers<3, 6>();
+        const auto poly2 = make_poly(make_test_coeffs(dense), dense);
+        REQUIRE(poly2.evaluate(CompensatedHorner<double>{}, 0.75, -1.25, 0.5) ==
+                doctest::Approx(poly2(0.75, -1.25, 0.5)));
+    }
+
+    SUBCASE("Error-free product without a fused multiply-add")
+    {
+        for (int i = 1; i <= 200; ++i)
+        {
+            const double a = 1.0 / (3 * i) - 0.7, b = std::sqrt(static_cast<double>(i)) * 1.0e3;
+            double p, e;
+            detail::two_prod_dekker(a, b, p, e);
+            REQUIRE(p == a * b);
+            REQUIRE(e == std::fma(a, b, -p));
+
+            const float af = static_cast<float>(a), bf = static_cast<float>(b);
+            float pf, ef;
+            detail::two_prod_dekker(af, bf, pf, ef);
+            REQUIRE(pf == af * bf);
+            REQUIRE(ef == std::fma(af, bf, -pf));
+        }
+    }
+}
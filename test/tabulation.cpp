@@ -0,0 +1,65 @@
+#include "Tabulation.hpp"
+#include "doctest.hpp"
+
+#include <cstdint>
+
+using namespace Polynomials;
+
+namespace
+{
+
+// Linear Lagrange basis on the reference triangle.
+constexpr auto basis = std::tuple{
+    make_poly(std::array{1.0, -1.0, -1.0}, PowersList<Powers<0, 0>, Powers<1, 0>, Powers<0, 1>>{}),
+    make_poly(std::array{1.0}, PowersList<Powers<1, 0>>{}),
+    make_poly(std::array{1.0}, PowersList<Powers<0, 1>>{})};
+
+constexpr std::array<std::array<double, 2>, 3> points{
+    {{1.0 / 6, 1.0 / 6}, {2.0 / 3, 1.0 / 6}, {1.0 / 6, 2.0 / 3}}};
+
+} // namespace
+
+TEST_CASE("Compile-time tabulation of a polynomial family")
+{
+    SUBCASE("Values only")
+    {
+        static constexpr auto table = tabulate(basis, points);
+        static_assert(table.num_points == 3 && table.num_functions == 3 && table.num_derivatives == 0);
+        static_assert(table.value(0, 1) == 1.0 / 6);
+        static_assert(table.value(1, 1) == 2.0 / 3);
+        static_assert(table.value(2, 2) == 2.0 / 3);
+        for (std::size_t q = 0; q < 3; ++q)
+        {
+            const double *row = table.values(q);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(row) % 64 == 0);
+            REQUIRE(row[0] + row[1] + row[2] == doctest::Approx(1.0));
+            REQUIRE(row[0] == doctest::Approx(std::get<0>(basis)(points[q][0], points[q][1])));
+        }
+    }
+
+    SUBCASE("Values and partial derivatives")
+    {
+        static constexpr auto table = tabulate_with_partials(basis, points);
+        static_assert(table.num_derivatives == 2);
+        for (std::size_t q = 0; q < 3; ++q)
+        {
+            REQUIRE(reinterpret_cast<std::uintptr_t>(table.values(q)) % 64 == 0);
+            REQUIRE(table.partial(q, 0, 0) == -1.0);
+            REQUIRE(table.partial(q, 1, 0) == -1.0);
+            REQUIRE(table.partial(q, 0, 1) == 1.0);
+            REQUIRE(table.partial(q, 1, 1) == 0.0);
+            REQUIRE(table.partials(q, 1)[2] == 1.0);
+            REQUIRE(table.values(q)[1] == table.value(q, 1));
+        }
+    }
+
+    SUBCASE("Integer coefficients are tabulated in the point type")
+    {
+        constexpr auto family = std::tuple{make_poly(std::tuple(1, 3), PowersList<Powers<0>, Powers<2>>{})};
+        static constexpr auto table =
+            tabulate_with_partials(family, std::array<std::array<double, 1>, 2>{{{0.5}, {-1.5}}});
+        static_assert(table.value(0, 0) == 1.75);
+        static_assert(table.value(1, 0) == 7.75);
+        static_assert(table.partial(1, 0, 0) == -9.0);
+    }
+}